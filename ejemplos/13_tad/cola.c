@@ -1,18 +1,182 @@
-// TAD Cola (Queue) - Implementación con lista enlazada
+// TAD Cola (Queue) - Implementación con lista enlazada o con arreglo circular
+//
+// La implementación se elige al compilar; las funciones cola_* son las
+// mismas en ambos casos:
+//     gcc cola.c                   -> lista enlazada de nodos
+//     gcc -DCOLA_CIRCULAR cola.c   -> arreglo circular que crece
+
+// El benchmark de asignación usa fork (POSIX) para medir la memoria de
+// cada variante en un proceso aparte, y el de operaciones lee los fallos
+// de caché con perf_event_open (solo Linux)
+#ifdef __linux__
+#define _DEFAULT_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#define COLA_CON_FORK
+#define COLA_CON_PERF
+#endif
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
 
-typedef struct Nodo {
-    int dato;
-    struct Nodo *siguiente;
-} Nodo;
+#ifdef COLA_CON_FORK
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#ifdef COLA_CON_PERF
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include "escritor.h"
+#include "pool_nodos.h"
+
+#ifdef COLA_CIRCULAR
+
+// Capacidad con la que nace la cola; siempre es potencia de dos
+#define CAPACIDAD_INICIAL_COLA 16
 
+// Los elementos ocupan posiciones contiguas del arreglo a partir de frente
+// y al llegar al final siguen desde el principio. Como la capacidad es
+// potencia de dos, la posición de frente + i es (frente + i) & (capacidad - 1),
+// sin divisiones ni comparaciones.
+typedef struct {
+    int *elementos;
+    int capacidad;
+    int frente;       // Posición del primer elemento
+    int tamano;
+} Cola;
+
+// Crea una cola vacía
+Cola *cola_crear(void) {
+    Cola *cola = malloc(sizeof(Cola));
+    if (cola == NULL) {
+        return NULL;
+    }
+    cola->elementos = malloc(CAPACIDAD_INICIAL_COLA * sizeof(int));
+    if (cola->elementos == NULL) {
+        free(cola);
+        return NULL;
+    }
+    cola->capacidad = CAPACIDAD_INICIAL_COLA;
+    cola->frente = 0;
+    cola->tamano = 0;
+    return cola;
+}
+
+// Verifica si la cola está vacía
+bool cola_vacia(const Cola *cola) {
+    return cola->tamano == 0;
+}
+
+// Retorna el tamaño de la cola
+int cola_tamano(const Cola *cola) {
+    return cola->tamano;
+}
+
+// Duplica la capacidad de una cola llena
+// Después del realloc los elementos pueden haber quedado partidos en dos
+// tramos: [frente, capacidad) y [0, frente). Se mueve el tramo más corto
+// para que vuelvan a quedar seguidos a partir del frente.
+static bool cola_redimensionar(Cola *cola) {
+    int capacidad = cola->capacidad;
+    if (capacidad > INT_MAX / 2) {
+        return false;
+    }
+    int *nuevos_elementos = realloc(cola->elementos,
+                                    (size_t)capacidad * 2 * sizeof(int));
+    if (nuevos_elementos == NULL) {
+        return false;
+    }
+    
+    int largo_final = capacidad - cola->frente;
+    if (cola->frente <= largo_final) {
+        // El tramo del principio pasa detrás del final
+        memcpy(nuevos_elementos + capacidad, nuevos_elementos,
+               cola->frente * sizeof(int));
+    } else {
+        // El tramo del final pasa al final del arreglo nuevo
+        memcpy(nuevos_elementos + capacidad + cola->frente,
+               nuevos_elementos + cola->frente,
+               largo_final * sizeof(int));
+        cola->frente += capacidad;
+    }
+    
+    cola->elementos = nuevos_elementos;
+    cola->capacidad = capacidad * 2;
+    return true;
+}
+
+// Encola un elemento (enqueue)
+bool cola_encolar(Cola *cola, int dato) {
+    if (cola->tamano == cola->capacidad && !cola_redimensionar(cola)) {
+        return false;
+    }
+    
+    int posicion = (cola->frente + cola->tamano) & (cola->capacidad - 1);
+    cola->elementos[posicion] = dato;
+    cola->tamano++;
+    return true;
+}
+
+// Desencola un elemento (dequeue)
+bool cola_desencolar(Cola *cola, int *dato) {
+    if (cola_vacia(cola)) {
+        return false;
+    }
+    
+    *dato = cola->elementos[cola->frente];
+    cola->frente = (cola->frente + 1) & (cola->capacidad - 1);
+    cola->tamano--;
+    return true;
+}
+
+// Ve el elemento al frente sin desencolar (peek)
+bool cola_frente(const Cola *cola, int *dato) {
+    if (cola_vacia(cola)) {
+        return false;
+    }
+    *dato = cola->elementos[cola->frente];
+    return true;
+}
+
+// Destruye la cola
+void cola_destruir(Cola *cola) {
+    free(cola->elementos);
+    free(cola);
+}
+
+// Imprime la cola
+void cola_imprimir(const Cola *cola) {
+    Escritor escritor;
+    escritor_iniciar(&escritor, stdout);
+    escritor_cadena(&escritor, "Cola (frente -> final): ");
+    int mascara = cola->capacidad - 1;
+    for (int i = 0; i < cola->tamano; i++) {
+        escritor_entero(&escritor,
+                        cola->elementos[(cola->frente + i) & mascara]);
+        escritor_cadena(&escritor, " ");
+    }
+    escritor_cadena(&escritor, "(tamaño: ");
+    escritor_entero(&escritor, cola->tamano);
+    escritor_cadena(&escritor, ")\n");
+    escritor_vaciar(&escritor);
+}
+
+#else
+
+// Los nodos salen de un pool propio en lugar de un malloc por nodo
 typedef struct {
     Nodo *frente;
     Nodo *final;
     int tamano;
+    PoolNodos pool;
 } Cola;
 
 // Crea una cola vacía
@@ -24,6 +188,7 @@ Cola *cola_crear(void) {
     cola->frente = NULL;
     cola->final = NULL;
     cola->tamano = 0;
+    pool_iniciar(&cola->pool);
     return cola;
 }
 
@@ -39,7 +204,7 @@ int cola_tamano(const Cola *cola) {
 
 // Encola un elemento (enqueue)
 bool cola_encolar(Cola *cola, int dato) {
-    Nodo *nuevo = malloc(sizeof(Nodo));
+    Nodo *nuevo = pool_obtener(&cola->pool);
     if (nuevo == NULL) {
         return false;
     }
@@ -73,7 +238,7 @@ bool cola_desencolar(Cola *cola, int *dato) {
         cola->final = NULL;
     }
     
-    free(a_eliminar);
+    pool_devolver(&cola->pool, a_eliminar);
     cola->tamano--;
     return true;
 }
@@ -88,26 +253,291 @@ bool cola_frente(const Cola *cola, int *dato) {
 }
 
 // Destruye la cola
+// Libera los slabs del pool de una vez, sin desencolar nodo por nodo
 void cola_destruir(Cola *cola) {
-    while (!cola_vacia(cola)) {
-        int dato;
-        cola_desencolar(cola, &dato);
-    }
+    pool_liberar_todo(&cola->pool);
     free(cola);
 }
 
 // Imprime la cola
 void cola_imprimir(const Cola *cola) {
-    printf("Cola (frente -> final): ");
+    Escritor escritor;
+    escritor_iniciar(&escritor, stdout);
+    escritor_cadena(&escritor, "Cola (frente -> final): ");
     Nodo *actual = cola->frente;
     while (actual != NULL) {
-        printf("%d ", actual->dato);
+        escritor_entero(&escritor, actual->dato);
+        escritor_cadena(&escritor, " ");
         actual = actual->siguiente;
     }
-    printf("(tamaño: %d)\n", cola->tamano);
+    escritor_cadena(&escritor, "(tamaño: ");
+    escritor_entero(&escritor, cola->tamano);
+    escritor_cadena(&escritor, ")\n");
+    escritor_vaciar(&escritor);
+}
+
+#endif // COLA_CIRCULAR
+
+#ifdef COLA_CON_FORK
+// Forma de pedir y devolver nodos que compara el benchmark
+typedef struct {
+    const char *nombre;
+    Nodo *(*obtener)(PoolNodos *pool);
+    void (*devolver)(PoolNodos *pool, Nodo *nodo);
+    void (*liberar_todo)(PoolNodos *pool, Nodo *frente);
+} Asignador;
+
+static Nodo *obtener_malloc(PoolNodos *pool) {
+    (void)pool;
+    return malloc(sizeof(Nodo));
+}
+
+static void devolver_malloc(PoolNodos *pool, Nodo *nodo) {
+    (void)pool;
+    free(nodo);
+}
+
+// Sin pool no queda otra que recorrer y liberar nodo por nodo
+static void liberar_todo_malloc(PoolNodos *pool, Nodo *frente) {
+    (void)pool;
+    while (frente != NULL) {
+        Nodo *viejo = frente;
+        frente = frente->siguiente;
+        free(viejo);
+    }
+}
+
+static Nodo *obtener_pool(PoolNodos *pool) {
+    return pool_obtener(pool);
+}
+
+static void devolver_pool(PoolNodos *pool, Nodo *nodo) {
+    pool_devolver(pool, nodo);
+}
+
+// Con el pool alcanza con liberar los slabs, sin tocar los nodos
+static void liberar_todo_pool(PoolNodos *pool, Nodo *frente) {
+    (void)frente;
+    pool_liberar_todo(pool);
+}
+
+// Lee un campo en KiB de /proc/self/status (VmRSS, VmHWM)
+static long leer_memoria_kib(const char *campo) {
+    FILE *estado = fopen("/proc/self/status", "r");
+    if (estado == NULL) {
+        return 0;
+    }
+    char linea[256];
+    long kib = 0;
+    size_t largo = strlen(campo);
+    while (fgets(linea, sizeof(linea), estado) != NULL) {
+        if (strncmp(linea, campo, largo) == 0 && linea[largo] == ':') {
+            kib = atol(linea + largo + 1);
+        }
+    }
+    fclose(estado);
+    return kib;
 }
 
-int main(void) {
+// En un proceso hijo: llena una cola FIFO de n nodos, la hace rotar
+// (un nodo nuevo al final, uno liberado al frente) rotaciones veces y la
+// libera. Reporta millones de asignaciones por segundo y memoria residente
+static void benchmark_asignador(const Asignador *asignador, int n,
+                                int rotaciones) {
+    fflush(stdout);
+    pid_t hijo = fork();
+    if (hijo < 0) {
+        perror("fork");
+        return;
+    }
+    if (hijo > 0) {
+        waitpid(hijo, NULL, 0);
+        return;
+    }
+    
+    long rss_inicial = leer_memoria_kib("VmRSS");
+    PoolNodos pool;
+    pool_iniciar(&pool);
+    Nodo *frente = NULL;
+    Nodo *final = NULL;
+    
+    clock_t inicio = clock();
+    for (int i = 0; i < n; i++) {
+        Nodo *nuevo = asignador->obtener(&pool);
+        nuevo->dato = i;
+        nuevo->siguiente = NULL;
+        if (final == NULL) {
+            frente = nuevo;
+        } else {
+            final->siguiente = nuevo;
+        }
+        final = nuevo;
+    }
+    double t_llenado = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    
+    inicio = clock();
+    for (int i = 0; i < rotaciones; i++) {
+        Nodo *nuevo = asignador->obtener(&pool);
+        nuevo->dato = i;
+        nuevo->siguiente = NULL;
+        final->siguiente = nuevo;
+        final = nuevo;
+        Nodo *viejo = frente;
+        frente = frente->siguiente;
+        asignador->devolver(&pool, viejo);
+    }
+    double t_rotacion = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    
+    long rss_pico = leer_memoria_kib("VmHWM");
+    inicio = clock();
+    asignador->liberar_todo(&pool, frente);
+    double t_vaciado = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    
+    printf("%-8s %12.1f %12.1f %12.4f %12.1f\n", asignador->nombre,
+           n / t_llenado / 1e6, rotaciones / t_rotacion / 1e6, t_vaciado,
+           (rss_pico - rss_inicial) / 1024.0);
+    fflush(stdout);
+    _exit(0);
+}
+
+// Compara malloc/free por nodo contra el pool de nodos
+static int benchmark_asignacion(int n) {
+    int rotaciones = 10 * n;
+    Asignador asignadores[] = {
+        {"malloc", obtener_malloc, devolver_malloc, liberar_todo_malloc},
+        {"pool", obtener_pool, devolver_pool, liberar_todo_pool}
+    };
+    
+    printf("Cola de %d nodos, %d rotaciones\n", n, rotaciones);
+    printf("%-8s %12s %12s %12s %12s\n", "nodos de", "llenar M/s",
+           "rotar M/s", "liberar (s)", "RSS (MiB)");
+    for (int i = 0; i < 2; i++) {
+        benchmark_asignador(&asignadores[i], n, rotaciones);
+    }
+    return 0;
+}
+#endif
+
+#ifdef COLA_CON_PERF
+// Abre un contador de fallos de caché del proceso (último nivel), o
+// retorna -1 si no está disponible: máquinas virtuales sin PMU o
+// perf_event_paranoid demasiado alto
+static int contador_abrir(void) {
+    struct perf_event_attr atributos;
+    memset(&atributos, 0, sizeof(atributos));
+    atributos.type = PERF_TYPE_HARDWARE;
+    atributos.size = sizeof(atributos);
+    atributos.config = PERF_COUNT_HW_CACHE_MISSES;
+    atributos.disabled = 1;
+    atributos.exclude_kernel = 1;
+    atributos.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &atributos, 0, -1, -1, 0);
+}
+
+static void contador_iniciar(int contador) {
+    if (contador >= 0) {
+        ioctl(contador, PERF_EVENT_IOC_RESET, 0);
+        ioctl(contador, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+// Detiene el contador y retorna la cuenta, o -1 si no hay contador
+static long long contador_detener(int contador) {
+    if (contador < 0) {
+        return -1;
+    }
+    ioctl(contador, PERF_EVENT_IOC_DISABLE, 0);
+    long long cuenta = 0;
+    if (read(contador, &cuenta, sizeof(cuenta)) != (ssize_t)sizeof(cuenta)) {
+        return -1;
+    }
+    return cuenta;
+}
+
+static void contador_cerrar(int contador) {
+    if (contador >= 0) {
+        close(contador);
+    }
+}
+#else
+static int contador_abrir(void) {
+    return -1;
+}
+
+static void contador_iniciar(int contador) {
+    (void)contador;
+}
+
+static long long contador_detener(int contador) {
+    (void)contador;
+    return -1;
+}
+
+static void contador_cerrar(int contador) {
+    (void)contador;
+}
+#endif
+
+// Llena una cola hasta tamano y la hace rotar (encolar al final y
+// desencolar del frente) rotaciones veces. Imprime millones de operaciones
+// por segundo de cada fase y los fallos de caché por operación al rotar.
+static void medir_rotacion(int tamano, int rotaciones, int contador) {
+    Cola *cola = cola_crear();
+    if (cola == NULL) {
+        return;
+    }
+    volatile long long sumidero = 0;
+    
+    clock_t inicio = clock();
+    for (int i = 0; i < tamano; i++) {
+        cola_encolar(cola, i);
+    }
+    double t_llenado = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    
+    contador_iniciar(contador);
+    inicio = clock();
+    for (int i = 0; i < rotaciones; i++) {
+        int dato = 0;
+        cola_encolar(cola, i);
+        cola_desencolar(cola, &dato);
+        sumidero += dato;
+    }
+    double t_rotacion = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    long long fallos = contador_detener(contador);
+    
+    printf("%12d %12.1f %12.1f", tamano, tamano / t_llenado / 1e6,
+           2.0 * rotaciones / t_rotacion / 1e6);
+    if (fallos < 0) {
+        printf(" %14s\n", "n/d");
+    } else {
+        printf(" %14.3f\n", (double)fallos / (2.0 * rotaciones));
+    }
+    cola_destruir(cola);
+}
+
+// Mide el rendimiento de la implementación compilada con colas chicas
+// (entran en L1) y grandes (no entran en ningún nivel de caché)
+static int benchmark(void) {
+#ifdef COLA_CIRCULAR
+    printf("Implementación: arreglo circular\n");
+#else
+    printf("Implementación: lista enlazada\n");
+#endif
+    int contador = contador_abrir();
+    if (contador < 0) {
+        printf("(contador de fallos de caché no disponible)\n");
+    }
+    printf("%12s %12s %12s %14s\n", "tamaño", "llenar M/s", "rotar M/s",
+           "fallos/op");
+    int tamanos[] = {16, 1000, 1000000, 10000000};
+    for (int i = 0; i < 4; i++) {
+        medir_rotacion(tamanos[i], 20000000, contador);
+    }
+    contador_cerrar(contador);
+    return 0;
+}
+
+static int demostracion(void) {
     Cola *mi_cola = cola_crear();
     if (mi_cola == NULL) {
         fprintf(stderr, "Error al crear la cola\n");
@@ -141,3 +571,30 @@ int main(void) {
     cola_destruir(mi_cola);
     return 0;
 }
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        return demostracion();
+    }
+    
+    if (strcmp(argv[1], "benchmark") == 0) {
+        return benchmark();
+    }
+
+#ifdef COLA_CON_FORK
+    if (strcmp(argv[1], "asignacion") == 0) {
+        int n = 1000000;
+        if (argc == 3) {
+            n = atoi(argv[2]);
+        }
+        if (n <= 0) {
+            fprintf(stderr, "La cantidad de nodos debe ser positiva\n");
+            return 1;
+        }
+        return benchmark_asignacion(n);
+    }
+#endif
+
+    printf("Uso: %s [benchmark | asignacion [nodos]]\n", argv[0]);
+    return 1;
+}
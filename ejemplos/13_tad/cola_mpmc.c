@@ -0,0 +1,560 @@
+// TAD Cola (Queue) - Varios productores y varios consumidores
+//
+// Cola acotada pensada como cola de trabajos de un pool de hilos. Es un
+// arreglo circular de celdas donde cada celda lleva un número de secuencia
+// (esquema de Dmitry Vyukov):
+//
+// - La celda de la posición p está libre para escribir cuando su
+//   secuencia vale p, y tiene un dato listo para leer cuando vale p + 1.
+// - Un productor toma la posición final con un CAS, escribe el dato y
+//   publica secuencia = p + 1 (release).
+// - Un consumidor toma la posición frente con un CAS, lee el dato y deja
+//   secuencia = p + capacidad (release): la celda queda libre para la
+//   próxima vuelta.
+//
+// No hay un malloc por elemento ni un candado global: los hilos solo
+// compiten por el CAS de final o de frente, y cada celda la toca un único
+// productor y un único consumidor por vuelta.
+//
+// Las variantes cola_intentar_* nunca esperan. cola_encolar y
+// cola_desencolar prueban primero sin bloquear y, si la cola está llena o
+// vacía, duermen en una variable de condición hasta que otro hilo avise o
+// se cumpla el tiempo límite. Los avisos solo toman el mutex si hay alguien
+// durmiendo, así que mientras la cola fluye no se usa.
+//
+// Compilar con: gcc -Wall -Wextra -std=c11 -pedantic -pthread cola_mpmc.c
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#define TAMANO_LINEA_CACHE 64
+
+// Tiempo de espera que significa "sin límite"
+#define SIN_LIMITE -1
+
+#define CAPACIDAD_BENCHMARK 1024
+#define MAXIMO_HILOS 16
+// Valor que el benchmark encola para avisar a un consumidor que termine
+#define FIN_DE_TRABAJO -1
+
+typedef struct {
+    _Atomic uint64_t secuencia;
+    int dato;
+} Celda;
+
+typedef struct {
+    alignas(TAMANO_LINEA_CACHE) _Atomic uint64_t final;
+    alignas(TAMANO_LINEA_CACHE) _Atomic uint64_t frente;
+    
+    // Solo lectura después de crear la cola
+    alignas(TAMANO_LINEA_CACHE) Celda *celdas;
+    uint64_t mascara;              // capacidad - 1, capacidad potencia de dos
+    
+    // Para las variantes que esperan
+    pthread_mutex_t candado;
+    pthread_cond_t hay_lugar;
+    pthread_cond_t hay_elementos;
+    _Atomic int esperando_lugar;
+    _Atomic int esperando_elementos;
+} ColaMpmc;
+
+// Crea una cola vacía con lugar para al menos capacidad elementos
+// (se redondea a la siguiente potencia de dos)
+ColaMpmc *cola_crear(uint32_t capacidad) {
+    if (capacidad < 2 || capacidad > (UINT32_C(1) << 31)) {
+        return NULL;
+    }
+    uint64_t redondeada = 1;
+    while (redondeada < capacidad) {
+        redondeada *= 2;
+    }
+    
+    ColaMpmc *cola = aligned_alloc(alignof(ColaMpmc), sizeof(ColaMpmc));
+    if (cola == NULL) {
+        return NULL;
+    }
+    cola->celdas = malloc(redondeada * sizeof(Celda));
+    if (cola->celdas == NULL) {
+        free(cola);
+        return NULL;
+    }
+    cola->mascara = redondeada - 1;
+    for (uint64_t i = 0; i < redondeada; i++) {
+        atomic_init(&cola->celdas[i].secuencia, i);
+    }
+    atomic_init(&cola->final, 0);
+    atomic_init(&cola->frente, 0);
+    
+    // Los plazos se miden con el reloj monótono, que no salta si cambia la
+    // hora del sistema
+    pthread_condattr_t atributos;
+    pthread_condattr_init(&atributos);
+    pthread_condattr_setclock(&atributos, CLOCK_MONOTONIC);
+    pthread_mutex_init(&cola->candado, NULL);
+    pthread_cond_init(&cola->hay_lugar, &atributos);
+    pthread_cond_init(&cola->hay_elementos, &atributos);
+    pthread_condattr_destroy(&atributos);
+    atomic_init(&cola->esperando_lugar, 0);
+    atomic_init(&cola->esperando_elementos, 0);
+    return cola;
+}
+
+// Destruye la cola; ningún hilo debe estar usándola
+void cola_destruir(ColaMpmc *cola) {
+    if (cola != NULL) {
+        pthread_cond_destroy(&cola->hay_lugar);
+        pthread_cond_destroy(&cola->hay_elementos);
+        pthread_mutex_destroy(&cola->candado);
+        free(cola->celdas);
+        free(cola);
+    }
+}
+
+// Encola sin esperar; retorna false si la cola está llena
+bool cola_intentar_encolar(ColaMpmc *cola, int dato) {
+    uint64_t posicion = atomic_load_explicit(&cola->final,
+                                             memory_order_relaxed);
+    Celda *celda;
+    while (true) {
+        celda = &cola->celdas[posicion & cola->mascara];
+        uint64_t secuencia = atomic_load_explicit(&celda->secuencia,
+                                                  memory_order_acquire);
+        int64_t diferencia = (int64_t)(secuencia - posicion);
+        if (diferencia == 0) {
+            // Celda libre: se intenta tomar la posición
+            if (atomic_compare_exchange_weak_explicit(
+                    &cola->final, &posicion, posicion + 1,
+                    memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diferencia < 0) {
+            // La celda todavía tiene el dato de la vuelta anterior
+            return false;
+        } else {
+            // Otro productor ya la tomó
+            posicion = atomic_load_explicit(&cola->final,
+                                            memory_order_relaxed);
+        }
+    }
+    celda->dato = dato;
+    atomic_store_explicit(&celda->secuencia, posicion + 1,
+                          memory_order_release);
+    return true;
+}
+
+// Desencola sin esperar; retorna false si la cola está vacía
+bool cola_intentar_desencolar(ColaMpmc *cola, int *dato) {
+    uint64_t posicion = atomic_load_explicit(&cola->frente,
+                                             memory_order_relaxed);
+    Celda *celda;
+    while (true) {
+        celda = &cola->celdas[posicion & cola->mascara];
+        uint64_t secuencia = atomic_load_explicit(&celda->secuencia,
+                                                  memory_order_acquire);
+        int64_t diferencia = (int64_t)(secuencia - (posicion + 1));
+        if (diferencia == 0) {
+            if (atomic_compare_exchange_weak_explicit(
+                    &cola->frente, &posicion, posicion + 1,
+                    memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diferencia < 0) {
+            // El productor de esta posición todavía no publicó
+            return false;
+        } else {
+            posicion = atomic_load_explicit(&cola->frente,
+                                            memory_order_relaxed);
+        }
+    }
+    *dato = celda->dato;
+    atomic_store_explicit(&celda->secuencia, posicion + cola->mascara + 1,
+                          memory_order_release);
+    return true;
+}
+
+// Despierta a un hilo que duerme en condicion, si hay alguno
+// La barrera seq_cst, junto con la del hilo que se duerme, garantiza que
+// o bien el que duerme ve la operación recién hecha, o bien acá se ve su
+// contador y se le avisa: no se pierden avisos.
+static void avisar(ColaMpmc *cola, pthread_cond_t *condicion,
+                   _Atomic int *esperando) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(esperando, memory_order_relaxed) > 0) {
+        pthread_mutex_lock(&cola->candado);
+        pthread_cond_signal(condicion);
+        pthread_mutex_unlock(&cola->candado);
+    }
+}
+
+// Momento en que vence una espera de milisegundos desde ahora
+static struct timespec plazo_desde_ahora(int milisegundos) {
+    struct timespec plazo;
+    clock_gettime(CLOCK_MONOTONIC, &plazo);
+    plazo.tv_sec += milisegundos / 1000;
+    plazo.tv_nsec += (long)(milisegundos % 1000) * 1000000;
+    if (plazo.tv_nsec >= 1000000000) {
+        plazo.tv_sec++;
+        plazo.tv_nsec -= 1000000000;
+    }
+    return plazo;
+}
+
+// Repite intentar hasta que tenga éxito o venza el plazo, durmiendo en
+// condicion entre intentos
+static bool esperar_y_reintentar(ColaMpmc *cola, pthread_cond_t *condicion,
+                                 _Atomic int *esperando, int milisegundos,
+                                 bool (*intentar)(ColaMpmc *, int *),
+                                 int *dato) {
+    struct timespec plazo = plazo_desde_ahora(0);
+    if (milisegundos != SIN_LIMITE) {
+        plazo = plazo_desde_ahora(milisegundos);
+    }
+    
+    bool ok = false;
+    pthread_mutex_lock(&cola->candado);
+    atomic_fetch_add_explicit(esperando, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    while (!(ok = intentar(cola, dato))) {
+        int resultado = 0;
+        if (milisegundos == SIN_LIMITE) {
+            resultado = pthread_cond_wait(condicion, &cola->candado);
+        } else {
+            resultado = pthread_cond_timedwait(condicion, &cola->candado,
+                                               &plazo);
+        }
+        if (resultado == ETIMEDOUT) {
+            ok = intentar(cola, dato);
+            break;
+        }
+    }
+    atomic_fetch_sub_explicit(esperando, 1, memory_order_relaxed);
+    pthread_mutex_unlock(&cola->candado);
+    return ok;
+}
+
+static bool intentar_encolar_desde(ColaMpmc *cola, int *dato) {
+    return cola_intentar_encolar(cola, *dato);
+}
+
+// Encola esperando hasta milisegundos a que haya lugar (SIN_LIMITE para
+// esperar lo que haga falta). Retorna false si venció el plazo.
+bool cola_encolar(ColaMpmc *cola, int dato, int milisegundos) {
+    bool ok = cola_intentar_encolar(cola, dato);
+    if (!ok && milisegundos != 0) {
+        ok = esperar_y_reintentar(cola, &cola->hay_lugar,
+                                  &cola->esperando_lugar, milisegundos,
+                                  intentar_encolar_desde, &dato);
+    }
+    if (ok) {
+        avisar(cola, &cola->hay_elementos, &cola->esperando_elementos);
+    }
+    return ok;
+}
+
+// Desencola esperando hasta milisegundos a que haya un elemento
+// (SIN_LIMITE para esperar lo que haga falta). Retorna false si venció el
+// plazo.
+bool cola_desencolar(ColaMpmc *cola, int *dato, int milisegundos) {
+    bool ok = cola_intentar_desencolar(cola, dato);
+    if (!ok && milisegundos != 0) {
+        ok = esperar_y_reintentar(cola, &cola->hay_elementos,
+                                  &cola->esperando_elementos, milisegundos,
+                                  cola_intentar_desencolar, dato);
+    }
+    if (ok) {
+        avisar(cola, &cola->hay_lugar, &cola->esperando_lugar);
+    }
+    return ok;
+}
+
+// Cantidad de elementos en la cola (aproximada si los hilos están
+// trabajando)
+int cola_tamano(ColaMpmc *cola) {
+    uint64_t frente = atomic_load_explicit(&cola->frente, memory_order_acquire);
+    uint64_t final = atomic_load_explicit(&cola->final, memory_order_acquire);
+    if (final < frente) {
+        return 0;
+    }
+    return (int)(final - frente);
+}
+
+// Verifica si la cola está vacía (puede cambiar apenas retorna)
+bool cola_vacia(ColaMpmc *cola) {
+    return cola_tamano(cola) == 0;
+}
+
+// Referencia para el benchmark: arreglo circular con un mutex global y dos
+// variables de condición, la cola de trabajos clásica
+typedef struct {
+    pthread_mutex_t candado;
+    pthread_cond_t hay_lugar;
+    pthread_cond_t hay_elementos;
+    int *elementos;
+    int capacidad;
+    int frente;
+    int tamano;
+} ColaConMutex;
+
+static void cola_mutex_encolar(ColaConMutex *cola, int dato) {
+    pthread_mutex_lock(&cola->candado);
+    while (cola->tamano == cola->capacidad) {
+        pthread_cond_wait(&cola->hay_lugar, &cola->candado);
+    }
+    int posicion = (cola->frente + cola->tamano) & (cola->capacidad - 1);
+    cola->elementos[posicion] = dato;
+    cola->tamano++;
+    pthread_cond_signal(&cola->hay_elementos);
+    pthread_mutex_unlock(&cola->candado);
+}
+
+static int cola_mutex_desencolar(ColaConMutex *cola) {
+    pthread_mutex_lock(&cola->candado);
+    while (cola->tamano == 0) {
+        pthread_cond_wait(&cola->hay_elementos, &cola->candado);
+    }
+    int dato = cola->elementos[cola->frente];
+    cola->frente = (cola->frente + 1) & (cola->capacidad - 1);
+    cola->tamano--;
+    pthread_cond_signal(&cola->hay_lugar);
+    pthread_mutex_unlock(&cola->candado);
+    return dato;
+}
+
+// Lo que recibe cada hilo del benchmark
+typedef struct {
+    ColaMpmc *cola;
+    ColaConMutex *cola_mutex;
+    int primer_valor;
+    int cantidad;
+    _Atomic int *vistos;        // Veces que salió cada valor
+    pthread_barrier_t *largada;
+} Trabajo;
+
+static void *productor_mpmc(void *argumento) {
+    Trabajo *trabajo = argumento;
+    pthread_barrier_wait(trabajo->largada);
+    for (int i = 0; i < trabajo->cantidad; i++) {
+        cola_encolar(trabajo->cola, trabajo->primer_valor + i, SIN_LIMITE);
+    }
+    return NULL;
+}
+
+static void *consumidor_mpmc(void *argumento) {
+    Trabajo *trabajo = argumento;
+    pthread_barrier_wait(trabajo->largada);
+    int dato = 0;
+    while (cola_desencolar(trabajo->cola, &dato, SIN_LIMITE) &&
+           dato != FIN_DE_TRABAJO) {
+        atomic_fetch_add_explicit(&trabajo->vistos[dato], 1,
+                                  memory_order_relaxed);
+    }
+    return NULL;
+}
+
+static void *productor_mutex(void *argumento) {
+    Trabajo *trabajo = argumento;
+    pthread_barrier_wait(trabajo->largada);
+    for (int i = 0; i < trabajo->cantidad; i++) {
+        cola_mutex_encolar(trabajo->cola_mutex, trabajo->primer_valor + i);
+    }
+    return NULL;
+}
+
+static void *consumidor_mutex(void *argumento) {
+    Trabajo *trabajo = argumento;
+    pthread_barrier_wait(trabajo->largada);
+    int dato;
+    while ((dato = cola_mutex_desencolar(trabajo->cola_mutex)) !=
+           FIN_DE_TRABAJO) {
+        atomic_fetch_add_explicit(&trabajo->vistos[dato], 1,
+                                  memory_order_relaxed);
+    }
+    return NULL;
+}
+
+static double segundos_ahora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Corre hilos productores y consumidores que pasan total valores por la
+// cola. Al terminar los productores se encola un FIN_DE_TRABAJO por
+// consumidor. Mide la cola con mutex si cola_mutex no es NULL y la
+// ColaMpmc si no. Retorna millones de elementos por segundo, o un valor
+// negativo si algún valor se perdió o salió dos veces.
+static double medir(ColaMpmc *cola, ColaConMutex *cola_mutex, int hilos,
+                    int total, _Atomic int *vistos) {
+    pthread_t productores[MAXIMO_HILOS];
+    pthread_t consumidores[MAXIMO_HILOS];
+    Trabajo trabajos[MAXIMO_HILOS];
+    pthread_barrier_t largada;
+    for (int i = 0; i < total; i++) {
+        atomic_store_explicit(&vistos[i], 0, memory_order_relaxed);
+    }
+    
+    // El hilo principal también pasa por la barrera para tomar el tiempo
+    pthread_barrier_init(&largada, NULL, 2 * hilos + 1);
+    int por_hilo = total / hilos;
+    for (int h = 0; h < hilos; h++) {
+        trabajos[h].cola = cola;
+        trabajos[h].cola_mutex = cola_mutex;
+        trabajos[h].primer_valor = h * por_hilo;
+        trabajos[h].cantidad = por_hilo;
+        if (h == hilos - 1) {
+            trabajos[h].cantidad = total - h * por_hilo;
+        }
+        trabajos[h].vistos = vistos;
+        trabajos[h].largada = &largada;
+        if (cola_mutex != NULL) {
+            pthread_create(&productores[h], NULL, productor_mutex,
+                           &trabajos[h]);
+            pthread_create(&consumidores[h], NULL, consumidor_mutex,
+                           &trabajos[h]);
+        } else {
+            pthread_create(&productores[h], NULL, productor_mpmc, &trabajos[h]);
+            pthread_create(&consumidores[h], NULL, consumidor_mpmc,
+                           &trabajos[h]);
+        }
+    }
+    
+    pthread_barrier_wait(&largada);
+    double inicio = segundos_ahora();
+    for (int h = 0; h < hilos; h++) {
+        pthread_join(productores[h], NULL);
+    }
+    for (int h = 0; h < hilos; h++) {
+        if (cola_mutex != NULL) {
+            cola_mutex_encolar(cola_mutex, FIN_DE_TRABAJO);
+        } else {
+            cola_encolar(cola, FIN_DE_TRABAJO, SIN_LIMITE);
+        }
+    }
+    for (int h = 0; h < hilos; h++) {
+        pthread_join(consumidores[h], NULL);
+    }
+    double segundos = segundos_ahora() - inicio;
+    pthread_barrier_destroy(&largada);
+    
+    for (int i = 0; i < total; i++) {
+        if (atomic_load_explicit(&vistos[i], memory_order_relaxed) != 1) {
+            return -1.0;
+        }
+    }
+    return total / segundos / 1e6;
+}
+
+// Cantidades de hilos del escalado: 1, 2, 4... y siempre maximo al final
+static int siguiente_cantidad_hilos(int hilos, int maximo) {
+    if (hilos < maximo && hilos * 2 > maximo) {
+        return maximo;
+    }
+    return hilos * 2;
+}
+
+// Escalado de 1 a maximo_hilos productores (y otros tantos consumidores)
+// contra la cola con mutex global
+static int benchmark_escalado(int maximo_hilos, int total) {
+    ColaMpmc *cola = cola_crear(CAPACIDAD_BENCHMARK);
+    ColaConMutex cola_mutex;
+    cola_mutex.elementos = malloc(CAPACIDAD_BENCHMARK * sizeof(int));
+    cola_mutex.capacidad = CAPACIDAD_BENCHMARK;
+    cola_mutex.frente = 0;
+    cola_mutex.tamano = 0;
+    _Atomic int *vistos = malloc(total * sizeof(_Atomic int));
+    if (cola == NULL || cola_mutex.elementos == NULL || vistos == NULL) {
+        fprintf(stderr, "No hay memoria para el benchmark\n");
+        cola_destruir(cola);
+        free(cola_mutex.elementos);
+        free(vistos);
+        return 1;
+    }
+    pthread_mutex_init(&cola_mutex.candado, NULL);
+    pthread_cond_init(&cola_mutex.hay_lugar, NULL);
+    pthread_cond_init(&cola_mutex.hay_elementos, NULL);
+    
+    printf("%d elementos, capacidad %d\n", total, CAPACIDAD_BENCHMARK);
+    printf("%12s %12s %12s\n", "prod/cons", "mpmc M/s", "mutex M/s");
+    int errores = 0;
+    for (int hilos = 1; hilos <= maximo_hilos;
+         hilos = siguiente_cantidad_hilos(hilos, maximo_hilos)) {
+        double sin_candado = medir(cola, NULL, hilos, total, vistos);
+        double con_mutex = medir(NULL, &cola_mutex, hilos, total, vistos);
+        if (sin_candado < 0 || con_mutex < 0) {
+            printf("%12d %12s\n", hilos, "ERROR: valores perdidos o repetidos");
+            errores++;
+            continue;
+        }
+        printf("%12d %12.2f %12.2f\n", hilos, sin_candado, con_mutex);
+    }
+    
+    pthread_cond_destroy(&cola_mutex.hay_lugar);
+    pthread_cond_destroy(&cola_mutex.hay_elementos);
+    pthread_mutex_destroy(&cola_mutex.candado);
+    free(cola_mutex.elementos);
+    free(vistos);
+    cola_destruir(cola);
+    return errores == 0 ? 0 : 1;
+}
+
+static int demostracion(void) {
+    ColaMpmc *mi_cola = cola_crear(2);
+    if (mi_cola == NULL) {
+        fprintf(stderr, "Error al crear la cola\n");
+        return 1;
+    }
+    
+    printf("Encolando sin esperar en una cola de capacidad 2:\n");
+    for (int valor = 10; valor <= 30; valor += 10) {
+        bool ok = cola_intentar_encolar(mi_cola, valor);
+        printf("  %d -> %s\n", valor, ok ? "encolado" : "llena");
+    }
+    
+    double inicio = segundos_ahora();
+    bool ok = cola_encolar(mi_cola, 30, 100);
+    printf("Encolar 30 esperando hasta 100 ms: %s (%.0f ms)\n",
+           ok ? "encolado" : "venció el plazo",
+           (segundos_ahora() - inicio) * 1000);
+    
+    int dato;
+    printf("Desencolando:\n");
+    while (cola_desencolar(mi_cola, &dato, 10)) {
+        printf("  %d\n", dato);
+    }
+    printf("Vacía: %s\n", cola_vacia(mi_cola) ? "sí" : "no");
+    
+    cola_destruir(mi_cola);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        return demostracion();
+    }
+    
+    if (strcmp(argv[1], "escalado") == 0) {
+        int maximo_hilos = MAXIMO_HILOS;
+        if (argc == 3) {
+            maximo_hilos = atoi(argv[2]);
+        }
+        if (maximo_hilos < 1 || maximo_hilos > MAXIMO_HILOS) {
+            fprintf(stderr, "La cantidad de hilos debe estar entre 1 y %d\n",
+                    MAXIMO_HILOS);
+            return 1;
+        }
+        return benchmark_escalado(maximo_hilos, 2000000);
+    }
+    
+    printf("Uso: %s [escalado [max_hilos]]\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,528 @@
+// TAD Cola de prioridad - Implementación con montículo d-ario
+//
+// Extrae siempre el elemento de menor prioridad (montículo de mínimo). El
+// montículo es un arreglo donde los hijos de la posición i están en
+// d * i + 1 ... d * i + d, con d (la aridad) igual a 2 o 4. Con d = 4 el
+// árbol tiene la mitad de niveles: insertar y disminuir hacen menos
+// comparaciones, y los 4 hijos de un nodo quedan juntos en memoria.
+//
+// Cada elemento insertado recibe una Manija que lo identifica mientras
+// esté en la cola, aunque el montículo lo cambie de posición. Con ella se
+// puede disminuir su prioridad en O(log n).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#define CAPACIDAD_INICIAL 16
+// Posición de una manija que no está en el montículo
+#define SIN_POSICION -1
+// Fin de la lista de manijas libres
+#define SIN_MANIJA -1
+
+typedef int Manija;
+
+// Lo que se compara al reordenar vive en el propio montículo, así no hay
+// que seguir un puntero por cada comparación
+typedef struct {
+    int prioridad;
+    Manija manija;
+} Entrada;
+
+// Datos asociados a cada manija. Una ranura libre tiene posicion =
+// SIN_POSICION y en dato guarda la siguiente ranura libre.
+typedef struct {
+    int posicion;               // Índice de la entrada en el montículo
+    int dato;
+} Ranura;
+
+typedef struct {
+    Entrada *monticulo;
+    int tamano;
+    int capacidad;
+    int bits_aridad;            // log2 de la aridad: 1 (binario) o 2
+    Ranura *ranuras;
+    int ranuras_usadas;
+    int capacidad_ranuras;
+    Manija primera_libre;
+} ColaPrioridad;
+
+static int padre(const ColaPrioridad *cp, int i) {
+    return (i - 1) >> cp->bits_aridad;
+}
+
+static int primer_hijo(const ColaPrioridad *cp, int i) {
+    return (i << cp->bits_aridad) + 1;
+}
+
+// Crea una cola de prioridad vacía con aridad 2 o 4
+// Retorna NULL si la aridad no es válida o no hay memoria
+ColaPrioridad *cola_prioridad_crear(int aridad) {
+    if (aridad != 2 && aridad != 4) {
+        return NULL;
+    }
+    ColaPrioridad *cp = malloc(sizeof(ColaPrioridad));
+    if (cp == NULL) {
+        return NULL;
+    }
+    cp->monticulo = malloc(CAPACIDAD_INICIAL * sizeof(Entrada));
+    cp->ranuras = malloc(CAPACIDAD_INICIAL * sizeof(Ranura));
+    if (cp->monticulo == NULL || cp->ranuras == NULL) {
+        free(cp->monticulo);
+        free(cp->ranuras);
+        free(cp);
+        return NULL;
+    }
+    cp->tamano = 0;
+    cp->capacidad = CAPACIDAD_INICIAL;
+    cp->bits_aridad = aridad == 2 ? 1 : 2;
+    cp->ranuras_usadas = 0;
+    cp->capacidad_ranuras = CAPACIDAD_INICIAL;
+    cp->primera_libre = SIN_MANIJA;
+    return cp;
+}
+
+// Destruye la cola de prioridad
+void cola_prioridad_destruir(ColaPrioridad *cp) {
+    if (cp != NULL) {
+        free(cp->monticulo);
+        free(cp->ranuras);
+        free(cp);
+    }
+}
+
+// Retorna la cantidad de elementos
+int cola_prioridad_tamano(const ColaPrioridad *cp) {
+    return cp->tamano;
+}
+
+// Verifica si la cola de prioridad está vacía
+bool cola_prioridad_vacia(const ColaPrioridad *cp) {
+    return cp->tamano == 0;
+}
+
+// Garantiza lugar para al menos cantidad entradas y ranuras
+static bool cola_prioridad_reservar(ColaPrioridad *cp, int cantidad) {
+    if (cantidad > cp->capacidad) {
+        int nueva_capacidad = cp->capacidad;
+        while (nueva_capacidad < cantidad) {
+            nueva_capacidad *= 2;
+        }
+        Entrada *nuevo = realloc(cp->monticulo,
+                                 nueva_capacidad * sizeof(Entrada));
+        if (nuevo == NULL) {
+            return false;
+        }
+        cp->monticulo = nuevo;
+        cp->capacidad = nueva_capacidad;
+    }
+    if (cantidad > cp->capacidad_ranuras) {
+        int nueva_capacidad = cp->capacidad_ranuras;
+        while (nueva_capacidad < cantidad) {
+            nueva_capacidad *= 2;
+        }
+        Ranura *nuevas = realloc(cp->ranuras, nueva_capacidad * sizeof(Ranura));
+        if (nuevas == NULL) {
+            return false;
+        }
+        cp->ranuras = nuevas;
+        cp->capacidad_ranuras = nueva_capacidad;
+    }
+    return true;
+}
+
+// Toma una ranura libre (o una nueva) para dato; antes hay que reservar
+static Manija cola_prioridad_nueva_manija(ColaPrioridad *cp, int dato) {
+    Manija manija = cp->primera_libre;
+    if (manija != SIN_MANIJA) {
+        cp->primera_libre = cp->ranuras[manija].dato;
+    } else {
+        manija = cp->ranuras_usadas;
+        cp->ranuras_usadas++;
+    }
+    cp->ranuras[manija].dato = dato;
+    return manija;
+}
+
+// Deja la entrada en la posición i y actualiza su manija
+static void colocar(ColaPrioridad *cp, int i, Entrada entrada) {
+    cp->monticulo[i] = entrada;
+    cp->ranuras[entrada.manija].posicion = i;
+}
+
+// Sube la entrada de la posición i mientras sea menor que su padre
+// En lugar de intercambiar en cada nivel, baja a los padres y escribe la
+// entrada una sola vez al final
+static void subir(ColaPrioridad *cp, int i) {
+    Entrada entrada = cp->monticulo[i];
+    while (i > 0) {
+        int p = padre(cp, i);
+        if (cp->monticulo[p].prioridad <= entrada.prioridad) {
+            break;
+        }
+        colocar(cp, i, cp->monticulo[p]);
+        i = p;
+    }
+    colocar(cp, i, entrada);
+}
+
+// Baja la entrada de la posición i mientras algún hijo sea menor
+static void bajar(ColaPrioridad *cp, int i) {
+    Entrada entrada = cp->monticulo[i];
+    int aridad = 1 << cp->bits_aridad;
+    while (true) {
+        int hijo = primer_hijo(cp, i);
+        if (hijo >= cp->tamano) {
+            break;
+        }
+        int ultimo = hijo + aridad;
+        if (ultimo > cp->tamano) {
+            ultimo = cp->tamano;
+        }
+        int menor = hijo;
+        for (int h = hijo + 1; h < ultimo; h++) {
+            if (cp->monticulo[h].prioridad < cp->monticulo[menor].prioridad) {
+                menor = h;
+            }
+        }
+        if (cp->monticulo[menor].prioridad >= entrada.prioridad) {
+            break;
+        }
+        colocar(cp, i, cp->monticulo[menor]);
+        i = menor;
+    }
+    colocar(cp, i, entrada);
+}
+
+// Inserta dato con la prioridad dada
+// Si manija no es NULL, guarda ahí la manija del elemento
+bool cola_prioridad_insertar(ColaPrioridad *cp, int prioridad, int dato,
+                             Manija *manija) {
+    // Siempre hay al menos tantas ranuras usadas como entradas
+    if (!cola_prioridad_reservar(cp, cp->ranuras_usadas + 1)) {
+        return false;
+    }
+    Manija nueva = cola_prioridad_nueva_manija(cp, dato);
+    cp->monticulo[cp->tamano].prioridad = prioridad;
+    cp->monticulo[cp->tamano].manija = nueva;
+    cp->tamano++;
+    subir(cp, cp->tamano - 1);
+    if (manija != NULL) {
+        *manija = nueva;
+    }
+    return true;
+}
+
+// Crea una cola de prioridad con n elementos de una vez, en O(n)
+// Se copian todas las entradas y se acomoda el montículo de abajo hacia
+// arriba (heapify), en lugar de n inserciones de O(log n).
+// Si manijas no es NULL, manijas[i] es la manija del elemento i.
+// Retorna NULL si n es negativo o faltan los arreglos.
+ColaPrioridad *cola_prioridad_desde_arreglo(int aridad, const int *prioridades,
+                                            const int *datos, int n,
+                                            Manija *manijas) {
+    if (n < 0 || (n > 0 && (prioridades == NULL || datos == NULL))) {
+        return NULL;
+    }
+    ColaPrioridad *cp = cola_prioridad_crear(aridad);
+    if (cp == NULL) {
+        return NULL;
+    }
+    if (!cola_prioridad_reservar(cp, n)) {
+        cola_prioridad_destruir(cp);
+        return NULL;
+    }
+    for (int i = 0; i < n; i++) {
+        cp->monticulo[i].prioridad = prioridades[i];
+        cp->monticulo[i].manija = i;
+        cp->ranuras[i].posicion = i;
+        cp->ranuras[i].dato = datos[i];
+        if (manijas != NULL) {
+            manijas[i] = i;
+        }
+    }
+    cp->tamano = n;
+    cp->ranuras_usadas = n;
+    // Las hojas ya son montículos; se arranca desde el padre del último
+    if (n > 1) {
+        for (int i = padre(cp, n - 1); i >= 0; i--) {
+            bajar(cp, i);
+        }
+    }
+    return cp;
+}
+
+// Ve el elemento de menor prioridad sin extraerlo
+bool cola_prioridad_minimo(const ColaPrioridad *cp, int *prioridad,
+                           int *dato) {
+    if (cola_prioridad_vacia(cp)) {
+        return false;
+    }
+    *prioridad = cp->monticulo[0].prioridad;
+    *dato = cp->ranuras[cp->monticulo[0].manija].dato;
+    return true;
+}
+
+// Extrae el elemento de menor prioridad
+// Su manija deja de ser válida y puede reutilizarse en otra inserción
+bool cola_prioridad_extraer(ColaPrioridad *cp, int *prioridad, int *dato) {
+    if (cola_prioridad_vacia(cp)) {
+        return false;
+    }
+    Manija manija = cp->monticulo[0].manija;
+    *prioridad = cp->monticulo[0].prioridad;
+    *dato = cp->ranuras[manija].dato;
+    
+    cp->ranuras[manija].posicion = SIN_POSICION;
+    cp->ranuras[manija].dato = cp->primera_libre;
+    cp->primera_libre = manija;
+    
+    cp->tamano--;
+    if (cp->tamano > 0) {
+        cp->monticulo[0] = cp->monticulo[cp->tamano];
+        bajar(cp, 0);
+    }
+    return true;
+}
+
+// Baja la prioridad del elemento de manija a nueva_prioridad
+// Retorna false si la manija no está en la cola o la prioridad nueva es
+// mayor que la actual
+bool cola_prioridad_disminuir(ColaPrioridad *cp, Manija manija,
+                              int nueva_prioridad) {
+    if (manija < 0 || manija >= cp->ranuras_usadas ||
+        cp->ranuras[manija].posicion == SIN_POSICION) {
+        return false;
+    }
+    int posicion = cp->ranuras[manija].posicion;
+    if (nueva_prioridad > cp->monticulo[posicion].prioridad) {
+        return false;
+    }
+    cp->monticulo[posicion].prioridad = nueva_prioridad;
+    subir(cp, posicion);
+    return true;
+}
+
+// Referencia para el benchmark: arreglo que se vuelve a ordenar con qsort
+// después de cada inserción, de mayor a menor prioridad para extraer el
+// mínimo del final
+typedef struct {
+    Entrada *entradas;
+    int tamano;
+} ArregloOrdenado;
+
+static int comparar_descendente(const void *a, const void *b) {
+    int x = ((const Entrada *)a)->prioridad;
+    int y = ((const Entrada *)b)->prioridad;
+    return (x < y) - (x > y);
+}
+
+static void arreglo_insertar(ArregloOrdenado *arreglo, int prioridad,
+                             int dato) {
+    arreglo->entradas[arreglo->tamano].prioridad = prioridad;
+    arreglo->entradas[arreglo->tamano].manija = dato;
+    arreglo->tamano++;
+    qsort(arreglo->entradas, arreglo->tamano, sizeof(Entrada),
+          comparar_descendente);
+}
+
+static int arreglo_extraer(ArregloOrdenado *arreglo) {
+    arreglo->tamano--;
+    return arreglo->entradas[arreglo->tamano].prioridad;
+}
+
+static double segundos_desde(clock_t inicio) {
+    return (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// Con n elementos en la cola, repite operaciones veces insertar uno y
+// extraer el mínimo. Retorna millones de pares por segundo.
+static double medir_monticulo(int aridad, const int *prioridades, int n,
+                              int operaciones) {
+    ColaPrioridad *cp = cola_prioridad_crear(aridad);
+    if (cp == NULL) {
+        return 0.0;
+    }
+    for (int i = 0; i < n; i++) {
+        cola_prioridad_insertar(cp, prioridades[i], i, NULL);
+    }
+    volatile long long sumidero = 0;
+    clock_t inicio = clock();
+    for (int i = 0; i < operaciones; i++) {
+        int prioridad = 0;
+        int dato = 0;
+        cola_prioridad_insertar(cp, prioridades[n + i], i, NULL);
+        cola_prioridad_extraer(cp, &prioridad, &dato);
+        sumidero += prioridad;
+    }
+    double segundos = segundos_desde(inicio);
+    cola_prioridad_destruir(cp);
+    return operaciones / segundos / 1e6;
+}
+
+static double medir_qsort(const int *prioridades, int n, int operaciones) {
+    ArregloOrdenado arreglo;
+    arreglo.entradas = malloc((n + 1) * sizeof(Entrada));
+    arreglo.tamano = 0;
+    if (arreglo.entradas == NULL) {
+        return 0.0;
+    }
+    for (int i = 0; i < n; i++) {
+        arreglo.entradas[i].prioridad = prioridades[i];
+        arreglo.entradas[i].manija = i;
+    }
+    arreglo.tamano = n;
+    qsort(arreglo.entradas, n, sizeof(Entrada), comparar_descendente);
+    
+    volatile long long sumidero = 0;
+    clock_t inicio = clock();
+    for (int i = 0; i < operaciones; i++) {
+        arreglo_insertar(&arreglo, prioridades[n + i], i);
+        sumidero += arreglo_extraer(&arreglo);
+    }
+    double segundos = segundos_desde(inicio);
+    free(arreglo.entradas);
+    return operaciones / segundos / 1e6;
+}
+
+// Arma la cola con n elementos: heapify contra n inserciones y contra un
+// único qsort. Retorna los segundos de cada forma en tiempos.
+static void medir_construccion(const int *prioridades, const int *datos,
+                               int n, double tiempos[3]) {
+    clock_t inicio = clock();
+    ColaPrioridad *cp = cola_prioridad_desde_arreglo(4, prioridades, datos, n,
+                                                     NULL);
+    tiempos[0] = segundos_desde(inicio);
+    cola_prioridad_destruir(cp);
+    
+    inicio = clock();
+    cp = cola_prioridad_crear(4);
+    for (int i = 0; cp != NULL && i < n; i++) {
+        cola_prioridad_insertar(cp, prioridades[i], datos[i], NULL);
+    }
+    tiempos[1] = segundos_desde(inicio);
+    cola_prioridad_destruir(cp);
+    
+    Entrada *entradas = malloc(n * sizeof(Entrada));
+    inicio = clock();
+    for (int i = 0; entradas != NULL && i < n; i++) {
+        entradas[i].prioridad = prioridades[i];
+        entradas[i].manija = datos[i];
+    }
+    if (entradas != NULL) {
+        qsort(entradas, n, sizeof(Entrada), comparar_descendente);
+    }
+    tiempos[2] = segundos_desde(inicio);
+    free(entradas);
+}
+
+// Compara insertar + extraer con montículo binario, montículo de aridad 4
+// y un arreglo que se reordena con qsort, y la construcción en bloque
+static int benchmark(void) {
+    int tamanos[] = {100, 1000, 10000, 100000, 1000000};
+    int cantidad_tamanos = 5;
+    int maximo = 1000000;
+    int operaciones = 1000000;
+    int *prioridades = malloc((maximo + operaciones) * sizeof(int));
+    int *datos = malloc(maximo * sizeof(int));
+    if (prioridades == NULL || datos == NULL) {
+        fprintf(stderr, "No hay memoria para el benchmark\n");
+        free(prioridades);
+        free(datos);
+        return 1;
+    }
+    srand(42);
+    for (int i = 0; i < maximo + operaciones; i++) {
+        prioridades[i] = rand();
+    }
+    for (int i = 0; i < maximo; i++) {
+        datos[i] = i;
+    }
+    
+    printf("Insertar + extraer el mínimo (M pares/s)\n");
+    printf("%10s %12s %12s %12s\n", "elementos", "binario", "aridad 4",
+           "qsort");
+    for (int t = 0; t < cantidad_tamanos; t++) {
+        int n = tamanos[t];
+        // Reordenar cuesta O(n log n) por operación: se hacen menos
+        int operaciones_qsort = 20000000 / n;
+        if (operaciones_qsort > operaciones) {
+            operaciones_qsort = operaciones;
+        }
+        if (operaciones_qsort < 10) {
+            operaciones_qsort = 10;
+        }
+        printf("%10d %12.2f %12.2f %12.4f\n", n,
+               medir_monticulo(2, prioridades, n, operaciones),
+               medir_monticulo(4, prioridades, n, operaciones),
+               medir_qsort(prioridades, n, operaciones_qsort));
+    }
+    
+    printf("\nConstrucción con %d elementos (s)\n", maximo);
+    double tiempos[3] = {0.0, 0.0, 0.0};
+    medir_construccion(prioridades, datos, maximo, tiempos);
+    printf("%12s %12s %12s\n", "heapify", "inserciones", "qsort");
+    printf("%12.4f %12.4f %12.4f\n", tiempos[0], tiempos[1], tiempos[2]);
+    
+    free(prioridades);
+    free(datos);
+    return 0;
+}
+
+static int demostracion(void) {
+    ColaPrioridad *cp = cola_prioridad_crear(4);
+    if (cp == NULL) {
+        fprintf(stderr, "Error al crear la cola de prioridad\n");
+        return 1;
+    }
+    
+    // dato = número de tarea, prioridad = cuándo debe correr
+    int prioridades[] = {50, 20, 40, 10, 30};
+    Manija manijas[5];
+    printf("Insertando tareas (tarea: prioridad):");
+    for (int i = 0; i < 5; i++) {
+        cola_prioridad_insertar(cp, prioridades[i], i, &manijas[i]);
+        printf(" %d:%d", i, prioridades[i]);
+    }
+    printf("\n");
+    
+    printf("La tarea 0 pasa de prioridad 50 a 5\n");
+    cola_prioridad_disminuir(cp, manijas[0], 5);
+    
+    int prioridad;
+    int dato;
+    printf("Extrayendo en orden de prioridad:\n");
+    while (cola_prioridad_extraer(cp, &prioridad, &dato)) {
+        printf("  tarea %d (prioridad %d)\n", dato, prioridad);
+    }
+    cola_prioridad_destruir(cp);
+    
+    int desordenadas[] = {7, 3, 9, 1, 5};
+    int tareas[] = {0, 1, 2, 3, 4};
+    cp = cola_prioridad_desde_arreglo(2, desordenadas, tareas, 5, NULL);
+    if (cp == NULL) {
+        fprintf(stderr, "Error al crear la cola de prioridad\n");
+        return 1;
+    }
+    if (cola_prioridad_minimo(cp, &prioridad, &dato)) {
+        printf("Construida desde un arreglo: mínimo tarea %d (prioridad %d)\n",
+               dato, prioridad);
+    }
+    cola_prioridad_destruir(cp);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        return demostracion();
+    }
+    
+    if (strcmp(argv[1], "benchmark") == 0) {
+        return benchmark();
+    }
+    
+    printf("Uso: %s [benchmark]\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,508 @@
+// TAD Cola (Queue) - Un productor y un consumidor, sin bloqueos
+//
+// Pensada para unir dos etapas de un pipeline (por ejemplo un hilo que lee
+// y otro que procesa). Con un solo hilo encolando y un solo hilo
+// desencolando no hace falta mutex ni CAS: cada índice lo escribe un único
+// hilo y el otro solo lo lee.
+//
+// - final lo escribe solo el productor; frente lo escribe solo el
+//   consumidor. Son contadores que solo crecen; la posición en el arreglo
+//   es contador & (capacidad - 1).
+// - El productor escribe el elemento y después publica final con release;
+//   el consumidor lee final con acquire y recién ahí lee el elemento. Lo
+//   mismo al revés con frente, para que el productor no pise un lugar que
+//   el consumidor todavía está leyendo.
+// - frente y final viven en líneas de caché distintas. Si compartieran
+//   línea, cada escritura de un hilo invalidaría la copia del otro aunque
+//   no lean el mismo dato (falso compartir).
+// - Cada hilo guarda la última copia que leyó del índice del otro y solo
+//   vuelve a leer el atómico cuando esa copia dice que la cola está llena
+//   (o vacía).
+//
+// Compilar con: gcc -Wall -Wextra -std=c11 -pedantic -pthread cola_spsc.c
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sched.h>
+
+#define TAMANO_LINEA_CACHE 64
+
+#define CAPACIDAD_BENCHMARK 1024
+#define TAMANO_LOTE 32
+
+typedef struct {
+    // Lado del productor
+    alignas(TAMANO_LINEA_CACHE) _Atomic uint64_t final;
+    uint64_t frente_visto;     // Última copia de frente que leyó el productor
+    
+    // Lado del consumidor
+    alignas(TAMANO_LINEA_CACHE) _Atomic uint64_t frente;
+    uint64_t final_visto;      // Última copia de final que leyó el consumidor
+    
+    // Solo lectura después de crear la cola
+    alignas(TAMANO_LINEA_CACHE) int *elementos;
+    uint64_t capacidad;        // Potencia de dos
+} ColaSpsc;
+
+// Crea una cola vacía con lugar para al menos capacidad elementos
+// (se redondea a la siguiente potencia de dos)
+ColaSpsc *cola_crear(uint32_t capacidad) {
+    if (capacidad == 0 || capacidad > (UINT32_C(1) << 31)) {
+        return NULL;
+    }
+    uint64_t redondeada = 1;
+    while (redondeada < capacidad) {
+        redondeada *= 2;
+    }
+    
+    // sizeof(ColaSpsc) ya es múltiplo de la alineación, como pide
+    // aligned_alloc
+    ColaSpsc *cola = aligned_alloc(alignof(ColaSpsc), sizeof(ColaSpsc));
+    if (cola == NULL) {
+        return NULL;
+    }
+    cola->elementos = malloc(redondeada * sizeof(int));
+    if (cola->elementos == NULL) {
+        free(cola);
+        return NULL;
+    }
+    cola->capacidad = redondeada;
+    atomic_init(&cola->final, 0);
+    atomic_init(&cola->frente, 0);
+    cola->frente_visto = 0;
+    cola->final_visto = 0;
+    return cola;
+}
+
+// Destruye la cola; ningún hilo debe estar usándola
+void cola_destruir(ColaSpsc *cola) {
+    if (cola != NULL) {
+        free(cola->elementos);
+        free(cola);
+    }
+}
+
+// Lugares libres según el productor; relee frente solo si hacen falta más
+// de los que creía tener
+static uint64_t lugares_libres(ColaSpsc *cola, uint64_t final,
+                               uint64_t necesarios) {
+    uint64_t libres = cola->capacidad - (final - cola->frente_visto);
+    if (libres < necesarios) {
+        cola->frente_visto = atomic_load_explicit(&cola->frente,
+                                                  memory_order_acquire);
+        libres = cola->capacidad - (final - cola->frente_visto);
+    }
+    return libres;
+}
+
+// Elementos disponibles según el consumidor; relee final solo si hacen
+// falta más de los que creía tener
+static uint64_t elementos_disponibles(ColaSpsc *cola, uint64_t frente,
+                                      uint64_t necesarios) {
+    uint64_t disponibles = cola->final_visto - frente;
+    if (disponibles < necesarios) {
+        cola->final_visto = atomic_load_explicit(&cola->final,
+                                                 memory_order_acquire);
+        disponibles = cola->final_visto - frente;
+    }
+    return disponibles;
+}
+
+// Encola un elemento; solo lo llama el hilo productor
+// Retorna false si la cola está llena
+bool cola_encolar(ColaSpsc *cola, int dato) {
+    uint64_t final = atomic_load_explicit(&cola->final, memory_order_relaxed);
+    if (lugares_libres(cola, final, 1) == 0) {
+        return false;
+    }
+    cola->elementos[final & (cola->capacidad - 1)] = dato;
+    atomic_store_explicit(&cola->final, final + 1, memory_order_release);
+    return true;
+}
+
+// Desencola un elemento; solo lo llama el hilo consumidor
+// Retorna false si la cola está vacía
+bool cola_desencolar(ColaSpsc *cola, int *dato) {
+    uint64_t frente = atomic_load_explicit(&cola->frente, memory_order_relaxed);
+    if (elementos_disponibles(cola, frente, 1) == 0) {
+        return false;
+    }
+    *dato = cola->elementos[frente & (cola->capacidad - 1)];
+    atomic_store_explicit(&cola->frente, frente + 1, memory_order_release);
+    return true;
+}
+
+// Encola hasta n elementos de datos con una sola publicación de final
+// Retorna cuántos entraron (puede ser menos que n si la cola se llena;
+// 0 si n no es positivo)
+int cola_encolar_lote(ColaSpsc *cola, const int *datos, int n) {
+    if (n <= 0) {
+        return 0;
+    }
+    uint64_t final = atomic_load_explicit(&cola->final, memory_order_relaxed);
+    uint64_t libres = lugares_libres(cola, final, (uint64_t)n);
+    int cantidad = n;
+    if ((uint64_t)cantidad > libres) {
+        cantidad = (int)libres;
+    }
+    uint64_t mascara = cola->capacidad - 1;
+    for (int i = 0; i < cantidad; i++) {
+        cola->elementos[(final + i) & mascara] = datos[i];
+    }
+    if (cantidad > 0) {
+        atomic_store_explicit(&cola->final, final + cantidad,
+                              memory_order_release);
+    }
+    return cantidad;
+}
+
+// Desencola hasta maximo elementos en datos con una sola publicación de
+// frente. Retorna cuántos salieron (0 si la cola está vacía o maximo no
+// es positivo)
+int cola_desencolar_lote(ColaSpsc *cola, int *datos, int maximo) {
+    if (maximo <= 0) {
+        return 0;
+    }
+    uint64_t frente = atomic_load_explicit(&cola->frente, memory_order_relaxed);
+    uint64_t disponibles = elementos_disponibles(cola, frente,
+                                                 (uint64_t)maximo);
+    int cantidad = maximo;
+    if ((uint64_t)cantidad > disponibles) {
+        cantidad = (int)disponibles;
+    }
+    uint64_t mascara = cola->capacidad - 1;
+    for (int i = 0; i < cantidad; i++) {
+        datos[i] = cola->elementos[(frente + i) & mascara];
+    }
+    if (cantidad > 0) {
+        atomic_store_explicit(&cola->frente, frente + cantidad,
+                              memory_order_release);
+    }
+    return cantidad;
+}
+
+// Cantidad de elementos en la cola (aproximada si los hilos están
+// trabajando)
+int cola_tamano(ColaSpsc *cola) {
+    uint64_t frente = atomic_load_explicit(&cola->frente, memory_order_acquire);
+    uint64_t final = atomic_load_explicit(&cola->final, memory_order_acquire);
+    return (int)(final - frente);
+}
+
+// Verifica si la cola está vacía (puede cambiar apenas retorna)
+bool cola_vacia(ColaSpsc *cola) {
+    return cola_tamano(cola) == 0;
+}
+
+// Referencia para el benchmark: arreglo circular protegido por un mutex,
+// como la cola que unía las etapas hasta ahora
+typedef struct {
+    pthread_mutex_t candado;
+    int *elementos;
+    int capacidad;
+    int frente;
+    int tamano;
+} ColaConMutex;
+
+static bool cola_mutex_encolar(ColaConMutex *cola, int dato) {
+    bool ok = false;
+    pthread_mutex_lock(&cola->candado);
+    if (cola->tamano < cola->capacidad) {
+        int posicion = (cola->frente + cola->tamano) & (cola->capacidad - 1);
+        cola->elementos[posicion] = dato;
+        cola->tamano++;
+        ok = true;
+    }
+    pthread_mutex_unlock(&cola->candado);
+    return ok;
+}
+
+static bool cola_mutex_desencolar(ColaConMutex *cola, int *dato) {
+    bool ok = false;
+    pthread_mutex_lock(&cola->candado);
+    if (cola->tamano > 0) {
+        *dato = cola->elementos[cola->frente];
+        cola->frente = (cola->frente + 1) & (cola->capacidad - 1);
+        cola->tamano--;
+        ok = true;
+    }
+    pthread_mutex_unlock(&cola->candado);
+    return ok;
+}
+
+typedef enum {
+    VARIANTE_MUTEX,
+    VARIANTE_SPSC,
+    VARIANTE_LOTE
+} Variante;
+
+static const char *NOMBRES_VARIANTE[] = {"mutex", "spsc", "spsc lote"};
+
+// Lo que comparten el productor y el consumidor del benchmark
+typedef struct {
+    Variante variante;
+    ColaSpsc *cola;
+    ColaConMutex *cola_mutex;
+    int cantidad;
+    int64_t *envios;            // Momento en que se encoló cada valor
+    int64_t *latencias;         // Espera de cada valor en la cola
+    int desordenados;           // Valores que llegaron fuera de orden
+    pthread_barrier_t *largada;
+} Trabajo;
+
+static int64_t nanosegundos_ahora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+// Al encontrar la cola llena o vacía se cede el procesador: con menos
+// núcleos que hilos, girar en el lugar solo demora al otro hilo
+static void esperar(void) {
+    sched_yield();
+}
+
+static void *hilo_productor(void *argumento) {
+    Trabajo *trabajo = argumento;
+    int lote[TAMANO_LOTE];
+    pthread_barrier_wait(trabajo->largada);
+    
+    int valor = 0;
+    while (valor < trabajo->cantidad) {
+        int n = 1;
+        if (trabajo->variante == VARIANTE_LOTE) {
+            n = trabajo->cantidad - valor;
+            if (n > TAMANO_LOTE) {
+                n = TAMANO_LOTE;
+            }
+        }
+        if (trabajo->envios != NULL) {
+            int64_t ahora = nanosegundos_ahora();
+            for (int i = 0; i < n; i++) {
+                trabajo->envios[valor + i] = ahora;
+            }
+        }
+        
+        int encolados = 0;
+        switch (trabajo->variante) {
+            case VARIANTE_MUTEX:
+                encolados = cola_mutex_encolar(trabajo->cola_mutex, valor);
+                break;
+            case VARIANTE_SPSC:
+                encolados = cola_encolar(trabajo->cola, valor);
+                break;
+            case VARIANTE_LOTE:
+                for (int i = 0; i < n; i++) {
+                    lote[i] = valor + i;
+                }
+                encolados = cola_encolar_lote(trabajo->cola, lote, n);
+                break;
+        }
+        if (encolados == 0) {
+            esperar();
+        }
+        valor += encolados;
+    }
+    return NULL;
+}
+
+// Recibe un valor: verifica el orden FIFO y anota la latencia
+static void recibir(Trabajo *trabajo, int esperado, int valor) {
+    if (valor != esperado) {
+        trabajo->desordenados++;
+    }
+    if (trabajo->envios != NULL) {
+        trabajo->latencias[valor] = nanosegundos_ahora() -
+                                    trabajo->envios[valor];
+    }
+}
+
+static void *hilo_consumidor(void *argumento) {
+    Trabajo *trabajo = argumento;
+    int lote[TAMANO_LOTE];
+    pthread_barrier_wait(trabajo->largada);
+    
+    int recibidos = 0;
+    while (recibidos < trabajo->cantidad) {
+        int dato = 0;
+        int desencolados = 0;
+        switch (trabajo->variante) {
+            case VARIANTE_MUTEX:
+                desencolados = cola_mutex_desencolar(trabajo->cola_mutex,
+                                                     &dato);
+                lote[0] = dato;
+                break;
+            case VARIANTE_SPSC:
+                desencolados = cola_desencolar(trabajo->cola, &dato);
+                lote[0] = dato;
+                break;
+            case VARIANTE_LOTE:
+                desencolados = cola_desencolar_lote(trabajo->cola, lote,
+                                                    TAMANO_LOTE);
+                break;
+        }
+        if (desencolados == 0) {
+            esperar();
+        }
+        for (int i = 0; i < desencolados; i++) {
+            recibir(trabajo, recibidos + i, lote[i]);
+        }
+        recibidos += desencolados;
+    }
+    return NULL;
+}
+
+// Pasa cantidad valores de un hilo a otro y retorna los segundos que
+// tardó. Si trabajo->envios no es NULL también se miden latencias.
+static double medir(Trabajo *trabajo) {
+    pthread_t productor;
+    pthread_t consumidor;
+    pthread_barrier_t largada;
+    // El hilo principal también pasa por la barrera para tomar el tiempo
+    pthread_barrier_init(&largada, NULL, 3);
+    trabajo->largada = &largada;
+    trabajo->desordenados = 0;
+    pthread_create(&productor, NULL, hilo_productor, trabajo);
+    pthread_create(&consumidor, NULL, hilo_consumidor, trabajo);
+    pthread_barrier_wait(&largada);
+    int64_t inicio = nanosegundos_ahora();
+    pthread_join(productor, NULL);
+    pthread_join(consumidor, NULL);
+    int64_t fin = nanosegundos_ahora();
+    pthread_barrier_destroy(&largada);
+    return (fin - inicio) / 1e9;
+}
+
+static int comparar_int64(const void *a, const void *b) {
+    int64_t x = *(const int64_t *)a;
+    int64_t y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Percentil p (0 a 100) de n valores ya ordenados
+static int64_t percentil(const int64_t *ordenados, int n, double p) {
+    int indice = (int)(p / 100.0 * (n - 1));
+    return ordenados[indice];
+}
+
+// Compara las tres variantes: ns por elemento con la cola a pleno y
+// latencia (tiempo desde que se encola hasta que se desencola)
+static int benchmark(int cantidad) {
+    ColaSpsc *cola = cola_crear(CAPACIDAD_BENCHMARK);
+    ColaConMutex cola_mutex;
+    cola_mutex.elementos = malloc(CAPACIDAD_BENCHMARK * sizeof(int));
+    cola_mutex.capacidad = CAPACIDAD_BENCHMARK;
+    cola_mutex.frente = 0;
+    cola_mutex.tamano = 0;
+    int64_t *envios = malloc(cantidad * sizeof(int64_t));
+    int64_t *latencias = malloc(cantidad * sizeof(int64_t));
+    if (cola == NULL || cola_mutex.elementos == NULL || envios == NULL ||
+        latencias == NULL) {
+        fprintf(stderr, "No hay memoria para el benchmark\n");
+        cola_destruir(cola);
+        free(cola_mutex.elementos);
+        free(envios);
+        free(latencias);
+        return 1;
+    }
+    pthread_mutex_init(&cola_mutex.candado, NULL);
+    
+    printf("%d elementos, capacidad %d, lotes de %d\n", cantidad,
+           CAPACIDAD_BENCHMARK, TAMANO_LOTE);
+    printf("%-10s %10s %12s %12s %8s\n", "variante", "ns/elem",
+           "p50 (ns)", "p99 (ns)", "orden");
+    int errores = 0;
+    for (int v = VARIANTE_MUTEX; v <= VARIANTE_LOTE; v++) {
+        Trabajo trabajo;
+        trabajo.variante = (Variante)v;
+        trabajo.cola = cola;
+        trabajo.cola_mutex = &cola_mutex;
+        trabajo.cantidad = cantidad;
+        
+        // Rendimiento sin tomar tiempos por elemento
+        trabajo.envios = NULL;
+        trabajo.latencias = NULL;
+        double segundos = medir(&trabajo);
+        int desordenados = trabajo.desordenados;
+        
+        // Latencia, en una segunda pasada
+        trabajo.envios = envios;
+        trabajo.latencias = latencias;
+        medir(&trabajo);
+        desordenados += trabajo.desordenados;
+        qsort(latencias, cantidad, sizeof(int64_t), comparar_int64);
+        
+        printf("%-10s %10.1f %12lld %12lld %8s\n", NOMBRES_VARIANTE[v],
+               segundos * 1e9 / cantidad,
+               (long long)percentil(latencias, cantidad, 50),
+               (long long)percentil(latencias, cantidad, 99),
+               desordenados == 0 ? "OK" : "ERROR");
+        errores += desordenados;
+    }
+    
+    pthread_mutex_destroy(&cola_mutex.candado);
+    cola_destruir(cola);
+    free(cola_mutex.elementos);
+    free(envios);
+    free(latencias);
+    return errores == 0 ? 0 : 1;
+}
+
+static int demostracion(void) {
+    ColaSpsc *mi_cola = cola_crear(4);
+    if (mi_cola == NULL) {
+        fprintf(stderr, "Error al crear la cola\n");
+        return 1;
+    }
+    
+    printf("Encolando de a uno: 10, 20, 30\n");
+    cola_encolar(mi_cola, 10);
+    cola_encolar(mi_cola, 20);
+    cola_encolar(mi_cola, 30);
+    printf("Tamaño: %d\n", cola_tamano(mi_cola));
+    
+    int lote[] = {40, 50, 60};
+    int encolados = cola_encolar_lote(mi_cola, lote, 3);
+    printf("Lote de 3 con capacidad 4: entraron %d\n", encolados);
+    
+    int salida[4];
+    int desencolados = cola_desencolar_lote(mi_cola, salida, 4);
+    printf("Desencolados en un lote:");
+    for (int i = 0; i < desencolados; i++) {
+        printf(" %d", salida[i]);
+    }
+    printf("\nVacía: %s\n", cola_vacia(mi_cola) ? "sí" : "no");
+    
+    cola_destruir(mi_cola);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        return demostracion();
+    }
+    
+    if (strcmp(argv[1], "benchmark") == 0) {
+        int cantidad = 2000000;
+        if (argc == 3) {
+            cantidad = atoi(argv[2]);
+        }
+        if (cantidad <= 0) {
+            fprintf(stderr, "La cantidad de elementos debe ser positiva\n");
+            return 1;
+        }
+        return benchmark(cantidad);
+    }
+    
+    printf("Uso: %s [benchmark [elementos]]\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,112 @@
+// Escritor de texto con buffer propio, sin printf
+//
+// Las funciones *_imprimir de los TADs llamaban a printf una vez por
+// elemento: cada llamada vuelve a interpretar la cadena de formato y pasa
+// por el bloqueo interno de stdio. El Escritor convierte los enteros a mano
+// sobre un buffer grande y lo entrega al FILE de destino con un único fwrite
+// por buffer lleno. Un fwrite de ese tamaño glibc lo envía directamente con
+// write, y al pasar por el mismo FILE se respeta el orden con los printf que
+// haya alrededor.
+//
+// Uso:
+//     Escritor escritor;
+//     escritor_iniciar(&escritor, stdout);
+//     escritor_cadena(&escritor, "valor: ");
+//     escritor_entero(&escritor, 42);
+//     escritor_vaciar(&escritor);
+
+#ifndef ESCRITOR_H
+#define ESCRITOR_H
+
+#include <stdio.h>
+#include <string.h>
+
+#define TAMANO_BUFFER_ESCRITOR (64 * 1024)
+// Dígitos de un long long con signo: 19 más el '-'
+#define MAXIMO_DIGITOS_ENTERO 20
+
+typedef struct {
+    FILE *destino;
+    size_t usados;
+    char buffer[TAMANO_BUFFER_ESCRITOR];
+} Escritor;
+
+// Prepara el escritor para escribir en destino (por ejemplo stdout)
+static inline void escritor_iniciar(Escritor *escritor, FILE *destino) {
+    escritor->destino = destino;
+    escritor->usados = 0;
+}
+
+// Entrega al destino todo lo acumulado en el buffer
+static inline void escritor_vaciar(Escritor *escritor) {
+    if (escritor->usados > 0) {
+        fwrite(escritor->buffer, 1, escritor->usados, escritor->destino);
+        escritor->usados = 0;
+    }
+}
+
+// Garantiza lugar para al menos bytes caracteres más en el buffer
+static inline void escritor_reservar(Escritor *escritor, size_t bytes) {
+    if (escritor->usados + bytes > TAMANO_BUFFER_ESCRITOR) {
+        escritor_vaciar(escritor);
+    }
+}
+
+// Agrega una cadena terminada en '\0'
+static inline void escritor_cadena(Escritor *escritor, const char *texto) {
+    size_t largo = strlen(texto);
+    if (largo > TAMANO_BUFFER_ESCRITOR) {
+        escritor_vaciar(escritor);
+        fwrite(texto, 1, largo, escritor->destino);
+        return;
+    }
+    escritor_reservar(escritor, largo);
+    memcpy(escritor->buffer + escritor->usados, texto, largo);
+    escritor->usados += largo;
+}
+
+// Agrega un entero en base 10
+// Los dígitos se generan de dos en dos con una tabla, de atrás hacia
+// adelante, en un arreglo temporal
+static inline void escritor_entero(Escritor *escritor, long long valor) {
+    static const char pares[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233"
+        "34353637383940414243444546474849505152535455565758596061626364656667"
+        "6869707172737475767778798081828384858687888990919293949596979899";
+    char digitos[MAXIMO_DIGITOS_ENTERO];
+    int posicion = MAXIMO_DIGITOS_ENTERO;
+
+    // Se trabaja en unsigned para que LLONG_MIN no desborde al negarlo
+    unsigned long long resto = (unsigned long long)valor;
+    if (valor < 0) {
+        resto = 0ULL - resto;
+    }
+
+    while (resto >= 100) {
+        unsigned indice = (unsigned)(resto % 100) * 2;
+        resto /= 100;
+        posicion -= 2;
+        digitos[posicion] = pares[indice];
+        digitos[posicion + 1] = pares[indice + 1];
+    }
+    if (resto >= 10) {
+        unsigned indice = (unsigned)resto * 2;
+        posicion -= 2;
+        digitos[posicion] = pares[indice];
+        digitos[posicion + 1] = pares[indice + 1];
+    } else {
+        posicion--;
+        digitos[posicion] = (char)('0' + resto);
+    }
+    if (valor < 0) {
+        posicion--;
+        digitos[posicion] = '-';
+    }
+
+    size_t largo = (size_t)(MAXIMO_DIGITOS_ENTERO - posicion);
+    escritor_reservar(escritor, largo);
+    memcpy(escritor->buffer + escritor->usados, digitos + posicion, largo);
+    escritor->usados += largo;
+}
+
+#endif // ESCRITOR_H
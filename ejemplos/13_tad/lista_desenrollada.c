@@ -0,0 +1,380 @@
+// TAD Lista Desenrollada (unrolled linked list)
+// Cada nodo guarda un arreglo chico de elementos en lugar de uno solo.
+// Recorrerla toca un nodo (una o dos líneas de caché) cada
+// ELEMENTOS_POR_NODO elementos, en vez de un nodo por elemento.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "escritor.h"
+#include "pool_nodos.h"
+
+// Tamaño de cada nodo: dos líneas de caché de 64 bytes
+#define BYTES_POR_NODO 128
+#define ELEMENTOS_POR_NODO \
+    ((BYTES_POR_NODO - sizeof(void *) - sizeof(int)) / sizeof(int))
+
+// Nodo con varios elementos; solo los primeros cantidad son válidos
+typedef struct NodoDesenrollado {
+    struct NodoDesenrollado *siguiente;
+    int cantidad;
+    int datos[ELEMENTOS_POR_NODO];
+} NodoDesenrollado;
+
+typedef struct {
+    NodoDesenrollado *cabeza;
+    NodoDesenrollado *final;
+    int longitud;
+} ListaDesenrollada;
+
+// Permite recorrer la lista elemento por elemento sin conocer los nodos
+typedef struct {
+    const NodoDesenrollado *nodo;
+    int posicion;
+} IteradorLista;
+
+// Crea una lista vacía
+ListaDesenrollada *lista_crear(void) {
+    ListaDesenrollada *lista = malloc(sizeof(ListaDesenrollada));
+    if (lista == NULL) {
+        return NULL;
+    }
+    lista->cabeza = NULL;
+    lista->final = NULL;
+    lista->longitud = 0;
+    return lista;
+}
+
+// Crea un nodo vacío
+static NodoDesenrollado *nodo_crear(void) {
+    NodoDesenrollado *nodo = malloc(sizeof(NodoDesenrollado));
+    if (nodo == NULL) {
+        return NULL;
+    }
+    nodo->siguiente = NULL;
+    nodo->cantidad = 0;
+    return nodo;
+}
+
+// Agrega un elemento al inicio
+// Si el primer nodo tiene lugar, se corren sus elementos una posición
+bool lista_agregar_inicio(ListaDesenrollada *lista, int dato) {
+    NodoDesenrollado *cabeza = lista->cabeza;
+    if (cabeza == NULL || cabeza->cantidad == (int)ELEMENTOS_POR_NODO) {
+        NodoDesenrollado *nuevo = nodo_crear();
+        if (nuevo == NULL) {
+            return false;
+        }
+        nuevo->siguiente = cabeza;
+        lista->cabeza = nuevo;
+        if (lista->final == NULL) {
+            lista->final = nuevo;
+        }
+        cabeza = nuevo;
+    }
+    
+    memmove(&cabeza->datos[1], &cabeza->datos[0],
+            cabeza->cantidad * sizeof(int));
+    cabeza->datos[0] = dato;
+    cabeza->cantidad++;
+    lista->longitud++;
+    return true;
+}
+
+// Agrega un elemento al final en O(1)
+bool lista_agregar_final(ListaDesenrollada *lista, int dato) {
+    NodoDesenrollado *final = lista->final;
+    if (final == NULL || final->cantidad == (int)ELEMENTOS_POR_NODO) {
+        NodoDesenrollado *nuevo = nodo_crear();
+        if (nuevo == NULL) {
+            return false;
+        }
+        if (final == NULL) {
+            lista->cabeza = nuevo;
+        } else {
+            final->siguiente = nuevo;
+        }
+        lista->final = nuevo;
+        final = nuevo;
+    }
+    
+    final->datos[final->cantidad] = dato;
+    final->cantidad++;
+    lista->longitud++;
+    return true;
+}
+
+// Quita el elemento en posicion del nodo
+// Si el nodo queda a menos de la mitad, absorbe elementos del siguiente
+// para que los nodos no queden casi vacíos; si queda vacío, se libera
+static void lista_quitar_de_nodo(ListaDesenrollada *lista,
+                                 NodoDesenrollado *anterior,
+                                 NodoDesenrollado *nodo, int posicion) {
+    memmove(&nodo->datos[posicion], &nodo->datos[posicion + 1],
+            (nodo->cantidad - posicion - 1) * sizeof(int));
+    nodo->cantidad--;
+    lista->longitud--;
+    
+    NodoDesenrollado *siguiente = nodo->siguiente;
+    if (nodo->cantidad < (int)ELEMENTOS_POR_NODO / 2 && siguiente != NULL &&
+        nodo->cantidad + siguiente->cantidad <= (int)ELEMENTOS_POR_NODO) {
+        memcpy(&nodo->datos[nodo->cantidad], siguiente->datos,
+               siguiente->cantidad * sizeof(int));
+        nodo->cantidad += siguiente->cantidad;
+        nodo->siguiente = siguiente->siguiente;
+        if (lista->final == siguiente) {
+            lista->final = nodo;
+        }
+        free(siguiente);
+    }
+    
+    if (nodo->cantidad == 0) {
+        if (anterior == NULL) {
+            lista->cabeza = nodo->siguiente;
+        } else {
+            anterior->siguiente = nodo->siguiente;
+        }
+        if (lista->final == nodo) {
+            lista->final = anterior;
+        }
+        free(nodo);
+    }
+}
+
+// Elimina el primer elemento
+bool lista_eliminar_inicio(ListaDesenrollada *lista) {
+    if (lista->cabeza == NULL) {
+        return false;
+    }
+    lista_quitar_de_nodo(lista, NULL, lista->cabeza, 0);
+    return true;
+}
+
+// Elimina la primera aparición de dato; retorna false si no está
+bool lista_eliminar(ListaDesenrollada *lista, int dato) {
+    NodoDesenrollado *anterior = NULL;
+    NodoDesenrollado *actual = lista->cabeza;
+    while (actual != NULL) {
+        for (int i = 0; i < actual->cantidad; i++) {
+            if (actual->datos[i] == dato) {
+                lista_quitar_de_nodo(lista, anterior, actual, i);
+                return true;
+            }
+        }
+        anterior = actual;
+        actual = actual->siguiente;
+    }
+    return false;
+}
+
+// Ubica un iterador al comienzo de la lista
+IteradorLista lista_iterador(const ListaDesenrollada *lista) {
+    IteradorLista iterador = {lista->cabeza, 0};
+    return iterador;
+}
+
+// Indica si quedan elementos por recorrer
+bool iterador_hay_siguiente(const IteradorLista *iterador) {
+    return iterador->nodo != NULL;
+}
+
+// Retorna el elemento actual y avanza; requiere iterador_hay_siguiente
+int iterador_siguiente(IteradorLista *iterador) {
+    int dato = iterador->nodo->datos[iterador->posicion];
+    iterador->posicion++;
+    if (iterador->posicion == iterador->nodo->cantidad) {
+        iterador->nodo = iterador->nodo->siguiente;
+        iterador->posicion = 0;
+    }
+    return dato;
+}
+
+// Imprime la lista separando los nodos con |
+void lista_imprimir(const ListaDesenrollada *lista) {
+    Escritor escritor;
+    escritor_iniciar(&escritor, stdout);
+    escritor_cadena(&escritor, "[");
+    const NodoDesenrollado *actual = lista->cabeza;
+    while (actual != NULL) {
+        for (int i = 0; i < actual->cantidad; i++) {
+            escritor_entero(&escritor, actual->datos[i]);
+            if (i < actual->cantidad - 1) {
+                escritor_cadena(&escritor, " ");
+            }
+        }
+        if (actual->siguiente != NULL) {
+            escritor_cadena(&escritor, " | ");
+        }
+        actual = actual->siguiente;
+    }
+    escritor_cadena(&escritor, "] (longitud: ");
+    escritor_entero(&escritor, lista->longitud);
+    escritor_cadena(&escritor, ")\n");
+    escritor_vaciar(&escritor);
+}
+
+// Destruye la lista completa
+void lista_destruir(ListaDesenrollada *lista) {
+    NodoDesenrollado *actual = lista->cabeza;
+    while (actual != NULL) {
+        NodoDesenrollado *siguiente = actual->siguiente;
+        free(actual);
+        actual = siguiente;
+    }
+    free(lista);
+}
+
+// Referencia para el benchmark: la Lista de lista_enlazada.c, un elemento
+// por nodo, con nodos del pool y puntero al último
+typedef struct {
+    Nodo *cabeza;
+    Nodo *final;
+    PoolNodos pool;
+} ListaSimple;
+
+static bool lista_simple_agregar_final(ListaSimple *lista, int dato) {
+    Nodo *nuevo = pool_obtener(&lista->pool);
+    if (nuevo == NULL) {
+        return false;
+    }
+    nuevo->dato = dato;
+    nuevo->siguiente = NULL;
+    if (lista->cabeza == NULL) {
+        lista->cabeza = nuevo;
+    } else {
+        lista->final->siguiente = nuevo;
+    }
+    lista->final = nuevo;
+    return true;
+}
+
+static double segundos_desde(clock_t inicio) {
+    return (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// Inserta n elementos al final y los recorre sumando, con ambas listas
+static void benchmark_tamano(int n) {
+    // Los tamaños chicos se repiten para que el tiempo sea medible
+    int repeticiones = 10000000 / n;
+    if (repeticiones < 1) {
+        repeticiones = 1;
+    }
+    double total = (double)n * repeticiones / 1e6;
+    long long suma_simple = 0;
+    long long suma_desenrollada = 0;
+    
+    ListaSimple simple;
+    simple.cabeza = NULL;
+    simple.final = NULL;
+    pool_iniciar(&simple.pool);
+    double t_insertar_simple = 0.0;
+    double t_recorrer_simple = 0.0;
+    for (int r = 0; r < repeticiones; r++) {
+        clock_t inicio = clock();
+        for (int i = 0; i < n; i++) {
+            lista_simple_agregar_final(&simple, i);
+        }
+        t_insertar_simple += segundos_desde(inicio);
+        
+        inicio = clock();
+        const Nodo *actual = simple.cabeza;
+        while (actual != NULL) {
+            suma_simple += actual->dato;
+            actual = actual->siguiente;
+        }
+        t_recorrer_simple += segundos_desde(inicio);
+        
+        pool_liberar_todo(&simple.pool);
+        simple.cabeza = NULL;
+        simple.final = NULL;
+    }
+    
+    double t_insertar_desenrollada = 0.0;
+    double t_recorrer_desenrollada = 0.0;
+    for (int r = 0; r < repeticiones; r++) {
+        ListaDesenrollada *lista = lista_crear();
+        clock_t inicio = clock();
+        for (int i = 0; i < n; i++) {
+            lista_agregar_final(lista, i);
+        }
+        t_insertar_desenrollada += segundos_desde(inicio);
+        
+        inicio = clock();
+        IteradorLista iterador = lista_iterador(lista);
+        while (iterador_hay_siguiente(&iterador)) {
+            suma_desenrollada += iterador_siguiente(&iterador);
+        }
+        t_recorrer_desenrollada += segundos_desde(inicio);
+        
+        lista_destruir(lista);
+    }
+    
+    printf("%10d %12.1f %12.1f %12.1f %12.1f%s\n", n,
+           total / t_insertar_simple, total / t_insertar_desenrollada,
+           total / t_recorrer_simple, total / t_recorrer_desenrollada,
+           suma_simple == suma_desenrollada ? "" : " (¡sumas distintas!)");
+}
+
+// Compara inserción y recorrido de 10^4 a 10^7 elementos (millones/s)
+static int benchmark(void) {
+    printf("%d elementos por nodo (%zu bytes)\n", (int)ELEMENTOS_POR_NODO,
+           sizeof(NodoDesenrollado));
+    printf("%10s %12s %12s %12s %12s\n", "elementos", "ins. simple",
+           "ins. desenr.", "rec. simple", "rec. desenr.");
+    for (int n = 10000; n <= 10000000; n *= 10) {
+        benchmark_tamano(n);
+    }
+    return 0;
+}
+
+static int demostracion(void) {
+    ListaDesenrollada *mi_lista = lista_crear();
+    if (mi_lista == NULL) {
+        fprintf(stderr, "Error al crear la lista\n");
+        return 1;
+    }
+    
+    printf("Agregando al final del 1 al 70\n");
+    for (int i = 1; i <= 70; i++) {
+        lista_agregar_final(mi_lista, i);
+    }
+    lista_imprimir(mi_lista);
+    
+    printf("\nAgregando al inicio: 0, -1\n");
+    lista_agregar_inicio(mi_lista, 0);
+    lista_agregar_inicio(mi_lista, -1);
+    lista_imprimir(mi_lista);
+    
+    printf("\nEliminando el primero y del 10 al 40\n");
+    lista_eliminar_inicio(mi_lista);
+    for (int i = 10; i <= 40; i++) {
+        lista_eliminar(mi_lista, i);
+    }
+    lista_imprimir(mi_lista);
+    
+    long long suma = 0;
+    IteradorLista iterador = lista_iterador(mi_lista);
+    while (iterador_hay_siguiente(&iterador)) {
+        suma += iterador_siguiente(&iterador);
+    }
+    printf("\nSuma de los elementos: %lld\n", suma);
+    
+    lista_destruir(mi_lista);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        return demostracion();
+    }
+    
+    if (strcmp(argv[1], "benchmark") == 0) {
+        return benchmark();
+    }
+    
+    printf("Uso: %s [benchmark]\n", argv[0]);
+    return 1;
+}
@@ -4,17 +4,20 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+#include <time.h>
 
-// Nodo de la lista
-typedef struct Nodo {
-    int dato;
-    struct Nodo *siguiente;
-} Nodo;
+#include "escritor.h"
+#include "pool_nodos.h"
 
 // Lista enlazada
+// Guarda también el último nodo para agregar al final en O(1)
+// Sus nodos salen de un pool propio en lugar de un malloc por nodo
 typedef struct {
     Nodo *cabeza;
+    Nodo *final;
     int longitud;
+    PoolNodos pool;
 } Lista;
 
 // Crea una lista vacía
@@ -24,13 +27,15 @@ Lista *lista_crear(void) {
         return NULL;
     }
     lista->cabeza = NULL;
+    lista->final = NULL;
     lista->longitud = 0;
+    pool_iniciar(&lista->pool);
     return lista;
 }
 
 // Agrega un elemento al inicio
 bool lista_agregar_inicio(Lista *lista, int dato) {
-    Nodo *nuevo = malloc(sizeof(Nodo));
+    Nodo *nuevo = pool_obtener(&lista->pool);
     if (nuevo == NULL) {
         return false;
     }
@@ -38,13 +43,16 @@ bool lista_agregar_inicio(Lista *lista, int dato) {
     nuevo->dato = dato;
     nuevo->siguiente = lista->cabeza;
     lista->cabeza = nuevo;
+    if (lista->final == NULL) {
+        lista->final = nuevo;
+    }
     lista->longitud++;
     return true;
 }
 
-// Agrega un elemento al final
+// Agrega un elemento al final en O(1) usando el puntero al último nodo
 bool lista_agregar_final(Lista *lista, int dato) {
-    Nodo *nuevo = malloc(sizeof(Nodo));
+    Nodo *nuevo = pool_obtener(&lista->pool);
     if (nuevo == NULL) {
         return false;
     }
@@ -55,12 +63,9 @@ bool lista_agregar_final(Lista *lista, int dato) {
     if (lista->cabeza == NULL) {
         lista->cabeza = nuevo;
     } else {
-        Nodo *actual = lista->cabeza;
-        while (actual->siguiente != NULL) {
-            actual = actual->siguiente;
-        }
-        actual->siguiente = nuevo;
+        lista->final->siguiente = nuevo;
     }
+    lista->final = nuevo;
     
     lista->longitud++;
     return true;
@@ -74,34 +79,269 @@ bool lista_eliminar_inicio(Lista *lista) {
     
     Nodo *a_eliminar = lista->cabeza;
     lista->cabeza = lista->cabeza->siguiente;
-    free(a_eliminar);
+    if (lista->cabeza == NULL) {
+        lista->final = NULL;
+    }
+    pool_devolver(&lista->pool, a_eliminar);
     lista->longitud--;
     return true;
 }
 
+// Mueve todos los nodos de origen al final de destino en O(1)
+// origen queda vacía (pero no se destruye)
+// Los slabs de origen pasan al pool de destino junto con sus nodos
+// Concatenar una lista consigo misma no hace nada: el último nodo
+// quedaría apuntando a la cabeza y la lista sería un ciclo
+void lista_concatenar(Lista *destino, Lista *origen) {
+    if (destino == origen || origen->cabeza == NULL) {
+        return;
+    }
+    
+    if (destino->cabeza == NULL) {
+        destino->cabeza = origen->cabeza;
+    } else {
+        destino->final->siguiente = origen->cabeza;
+    }
+    destino->final = origen->final;
+    destino->longitud += origen->longitud;
+    
+    pool_absorber(&destino->pool, &origen->pool);
+    origen->cabeza = NULL;
+    origen->final = NULL;
+    origen->longitud = 0;
+}
+
+// Separa los primeros cantidad nodos desde inicio y retorna el resto
+// (NULL si no alcanzan)
+static Nodo *lista_cortar(Nodo *inicio, int cantidad) {
+    for (int i = 1; i < cantidad && inicio != NULL; i++) {
+        inicio = inicio->siguiente;
+    }
+    if (inicio == NULL) {
+        return NULL;
+    }
+    Nodo *resto = inicio->siguiente;
+    inicio->siguiente = NULL;
+    return resto;
+}
+
+// Fusiona dos cadenas ordenadas enlazándolas detrás de final
+// Retorna el último nodo de la cadena resultante
+// Ante empates toma primero de izquierda, así el orden es estable
+static Nodo *lista_fusionar(Nodo *izquierda, Nodo *derecha, Nodo *final) {
+    while (izquierda != NULL && derecha != NULL) {
+        if (izquierda->dato <= derecha->dato) {
+            final->siguiente = izquierda;
+            izquierda = izquierda->siguiente;
+        } else {
+            final->siguiente = derecha;
+            derecha = derecha->siguiente;
+        }
+        final = final->siguiente;
+    }
+    
+    if (izquierda != NULL) {
+        final->siguiente = izquierda;
+    } else {
+        final->siguiente = derecha;
+    }
+    while (final->siguiente != NULL) {
+        final = final->siguiente;
+    }
+    return final;
+}
+
+// Ordena la lista de menor a mayor en O(n log n)
+// Merge sort de abajo hacia arriba: en cada pasada fusiona tramos de
+// ancho 1, 2, 4, ... reenlazando los nodos existentes, sin recursión, sin
+// pedir memoria y sin copiar datos
+void lista_ordenar(Lista *lista) {
+    for (int ancho = 1; ancho < lista->longitud; ancho *= 2) {
+        // El centinela evita tratar aparte el primer tramo fusionado
+        Nodo centinela;
+        centinela.siguiente = NULL;
+        Nodo *final = &centinela;
+        Nodo *resto = lista->cabeza;
+        
+        while (resto != NULL) {
+            Nodo *izquierda = resto;
+            Nodo *derecha = lista_cortar(izquierda, ancho);
+            resto = lista_cortar(derecha, ancho);
+            final = lista_fusionar(izquierda, derecha, final);
+        }
+        
+        lista->cabeza = centinela.siguiente;
+        lista->final = final;
+    }
+}
+
 // Imprime la lista
 void lista_imprimir(const Lista *lista) {
+    Escritor escritor;
+    escritor_iniciar(&escritor, stdout);
     Nodo *actual = lista->cabeza;
-    printf("[");
+    escritor_cadena(&escritor, "[");
     while (actual != NULL) {
-        printf("%d", actual->dato);
+        escritor_entero(&escritor, actual->dato);
         if (actual->siguiente != NULL) {
-            printf(" -> ");
+            escritor_cadena(&escritor, " -> ");
         }
         actual = actual->siguiente;
     }
-    printf("] (longitud: %d)\n", lista->longitud);
+    escritor_cadena(&escritor, "] (longitud: ");
+    escritor_entero(&escritor, lista->longitud);
+    escritor_cadena(&escritor, ")\n");
+    escritor_vaciar(&escritor);
 }
 
 // Destruye la lista completa
+// Libera los slabs del pool de una vez, sin recorrer los nodos
 void lista_destruir(Lista *lista) {
+    pool_liberar_todo(&lista->pool);
+    free(lista);
+}
+
+// Versión anterior de lista_agregar_final: recorre toda la lista para
+// encontrar el último nodo, así que construir n elementos es O(n²)
+static bool lista_agregar_final_recorriendo(Lista *lista, int dato) {
+    Nodo *nuevo = pool_obtener(&lista->pool);
+    if (nuevo == NULL) {
+        return false;
+    }
+    
+    nuevo->dato = dato;
+    nuevo->siguiente = NULL;
+    
+    if (lista->cabeza == NULL) {
+        lista->cabeza = nuevo;
+    } else {
+        Nodo *actual = lista->cabeza;
+        while (actual->siguiente != NULL) {
+            actual = actual->siguiente;
+        }
+        actual->siguiente = nuevo;
+    }
+    lista->final = nuevo;
+    
+    lista->longitud++;
+    return true;
+}
+
+// Construye una lista de n elementos agregando al final y retorna segundos
+static double medir_construccion(int n, bool (*agregar)(Lista *, int)) {
+    Lista *lista = lista_crear();
+    clock_t inicio = clock();
+    for (int i = 0; i < n; i++) {
+        agregar(lista, i);
+    }
+    double segundos = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    lista_destruir(lista);
+    return segundos;
+}
+
+// Construye listas de 10^3 a 10^6 elementos con ambas versiones
+// La versión que recorre solo se mide hasta maximo_recorriendo elementos;
+// para tamaños mayores se estima escalando el último tiempo por (n/m)²
+static int benchmark_construccion(int maximo_recorriendo) {
+    printf("%10s %16s %16s\n", "elementos", "con final (s)", "recorriendo (s)");
+    double ultimo = 0.0;
+    int n_ultimo = 0;
+    for (int n = 1000; n <= 1000000; n *= 10) {
+        double con_final = medir_construccion(n, lista_agregar_final);
+        if (n <= maximo_recorriendo) {
+            ultimo = medir_construccion(n, lista_agregar_final_recorriendo);
+            n_ultimo = n;
+            printf("%10d %16.4f %16.4f\n", n, con_final, ultimo);
+        } else {
+            double factor = (double)n / n_ultimo;
+            printf("%10d %16.4f %16.1f (estimado)\n", n, con_final,
+                   ultimo * factor * factor);
+        }
+    }
+    return 0;
+}
+
+static int comparar_enteros(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Alternativa a lista_ordenar: copia a un arreglo, usa qsort y vuelve a
+// armar la lista con los valores ordenados
+static bool lista_ordenar_con_qsort(Lista *lista) {
+    int n = lista->longitud;
+    int *arreglo = malloc(n * sizeof(int));
+    if (arreglo == NULL) {
+        return false;
+    }
+    
+    int i = 0;
+    Nodo *actual = lista->cabeza;
+    while (actual != NULL) {
+        arreglo[i] = actual->dato;
+        i++;
+        actual = actual->siguiente;
+    }
+    qsort(arreglo, n, sizeof(int), comparar_enteros);
+    
     while (lista->cabeza != NULL) {
         lista_eliminar_inicio(lista);
     }
-    free(lista);
+    for (i = 0; i < n; i++) {
+        lista_agregar_final(lista, arreglo[i]);
+    }
+    
+    free(arreglo);
+    return true;
+}
+
+// Verifica que la lista quedó ordenada y que final apunta al último
+static bool lista_esta_ordenada(const Lista *lista) {
+    const Nodo *actual = lista->cabeza;
+    while (actual != NULL && actual->siguiente != NULL) {
+        if (actual->dato > actual->siguiente->dato) {
+            return false;
+        }
+        actual = actual->siguiente;
+    }
+    return actual == lista->final;
+}
+
+// Ordena una lista de n valores al azar y retorna los segundos empleados
+static double medir_ordenamiento(int n, bool usar_qsort) {
+    Lista *lista = lista_crear();
+    srand(n);
+    for (int i = 0; i < n; i++) {
+        lista_agregar_final(lista, rand());
+    }
+    
+    clock_t inicio = clock();
+    if (usar_qsort) {
+        lista_ordenar_con_qsort(lista);
+    } else {
+        lista_ordenar(lista);
+    }
+    double segundos = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    
+    if (!lista_esta_ordenada(lista)) {
+        printf("¡La lista de %d elementos no quedó ordenada!\n", n);
+    }
+    lista_destruir(lista);
+    return segundos;
 }
 
-int main(void) {
+// Compara lista_ordenar contra arreglo + qsort + reconstrucción
+static int benchmark_ordenamiento(int maximo) {
+    printf("%10s %17s %16s\n", "elementos", "lista_ordenar (s)", "qsort (s)");
+    for (int n = 10000; n <= maximo; n *= 10) {
+        printf("%10d %17.4f %16.4f\n", n, medir_ordenamiento(n, false),
+               medir_ordenamiento(n, true));
+    }
+    return 0;
+}
+
+static int demostracion(void) {
     Lista *mi_lista = lista_crear();
     if (mi_lista == NULL) {
         fprintf(stderr, "Error al crear la lista\n");
@@ -123,6 +363,58 @@ int main(void) {
     lista_eliminar_inicio(mi_lista);
     lista_imprimir(mi_lista);
     
+    printf("\nConcatenando otra lista con 60, 70\n");
+    Lista *otra = lista_crear();
+    if (otra != NULL) {
+        lista_agregar_final(otra, 60);
+        lista_agregar_final(otra, 70);
+        lista_concatenar(mi_lista, otra);
+        lista_destruir(otra);
+    }
+    lista_imprimir(mi_lista);
+    
+    printf("\nAgregando al inicio: 45, 5, 65 y ordenando\n");
+    lista_agregar_inicio(mi_lista, 45);
+    lista_agregar_inicio(mi_lista, 5);
+    lista_agregar_inicio(mi_lista, 65);
+    lista_ordenar(mi_lista);
+    lista_imprimir(mi_lista);
+    
     lista_destruir(mi_lista);
     return 0;
 }
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        return demostracion();
+    }
+    
+    if (strcmp(argv[1], "construccion") == 0) {
+        int maximo_recorriendo = 10000;
+        if (argc == 3) {
+            maximo_recorriendo = atoi(argv[2]);
+        }
+        if (maximo_recorriendo < 1000) {
+            fprintf(stderr, "El máximo debe ser al menos 1000\n");
+            return 1;
+        }
+        return benchmark_construccion(maximo_recorriendo);
+    }
+    
+    if (strcmp(argv[1], "ordenamiento") == 0) {
+        int maximo = 1000000;
+        if (argc == 3) {
+            maximo = atoi(argv[2]);
+        }
+        // Con más de 10^8, el n *= 10 del benchmark desbordaría int
+        if (maximo < 10000 || maximo > 100000000) {
+            fprintf(stderr, "El máximo debe estar entre 10000 y 100000000\n");
+            return 1;
+        }
+        return benchmark_ordenamiento(maximo);
+    }
+    
+    printf("Uso: %s [construccion [maximo_recorriendo] |\n"
+           "        ordenamiento [maximo_elementos]]\n", argv[0]);
+    return 1;
+}
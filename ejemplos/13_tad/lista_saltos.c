@@ -0,0 +1,503 @@
+// TAD Conjunto ordenado - Implementación con lista por saltos (skip list)
+//
+// Es una lista enlazada ordenada donde cada nodo, además del enlace al
+// siguiente, puede tener enlaces que saltan más lejos. El nivel 0 enlaza
+// todos los nodos; el nivel 1, más o menos uno de cada cuatro; el nivel 2,
+// uno de cada dieciséis, y así. Para buscar se avanza por el nivel más
+// alto hasta pasarse y se baja un nivel: en promedio O(log n) pasos para
+// buscar, insertar y eliminar, sin tener que rebalancear como un árbol.
+//
+// El nivel de cada nodo se sortea al insertarlo. Sus enlaces van en un
+// arreglo flexible dentro del mismo nodo: un solo malloc por nodo, y el
+// dato y los enlaces quedan juntos en memoria.
+//
+// Recorrer un rango es buscar el primero y seguir por el nivel 0, como
+// en una Lista común.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "escritor.h"
+#include "pool_nodos.h"
+
+// Con probabilidad 1/4 de subir de nivel alcanza para 4^16 elementos
+#define MAXIMO_NIVEL 16
+
+typedef struct NodoSaltos {
+    int dato;
+    int nivel;                          // Cantidad de enlaces
+    struct NodoSaltos *siguientes[];    // siguientes[i]: siguiente en el nivel i
+} NodoSaltos;
+
+typedef struct {
+    NodoSaltos *cabeza[MAXIMO_NIVEL];   // Primer nodo de cada nivel
+    int nivel;                          // Niveles en uso
+    int longitud;
+    uint32_t semilla;                   // Estado del sorteo de niveles
+} ListaSaltos;
+
+// Recorre los elementos de un rango en orden
+typedef struct {
+    const NodoSaltos *nodo;
+    int hasta;
+} IteradorRango;
+
+// Crea una lista vacía
+ListaSaltos *lista_saltos_crear(void) {
+    ListaSaltos *lista = malloc(sizeof(ListaSaltos));
+    if (lista == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < MAXIMO_NIVEL; i++) {
+        lista->cabeza[i] = NULL;
+    }
+    lista->nivel = 1;
+    lista->longitud = 0;
+    lista->semilla = 2463534242u;
+    return lista;
+}
+
+// Retorna la cantidad de elementos
+int lista_saltos_longitud(const ListaSaltos *lista) {
+    return lista->longitud;
+}
+
+// Sortea el nivel de un nodo nuevo: 1, y cada nivel extra con
+// probabilidad 1/4 (dos bits en cero del generador xorshift)
+static int lista_saltos_sortear_nivel(ListaSaltos *lista) {
+    uint32_t x = lista->semilla;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    lista->semilla = x;
+    
+    int nivel = 1;
+    while ((x & 3) == 0 && nivel < MAXIMO_NIVEL) {
+        nivel++;
+        x >>= 2;
+    }
+    return nivel;
+}
+
+// Enlace en el nivel i que sale de nodo; NULL representa la cabeza
+static NodoSaltos **enlace(ListaSaltos *lista, NodoSaltos *nodo, int i) {
+    if (nodo == NULL) {
+        return &lista->cabeza[i];
+    }
+    return &nodo->siguientes[i];
+}
+
+// Busca el último nodo menor que dato en cada nivel y lo deja en
+// anteriores (NULL si es la cabeza). Retorna el primer nodo >= dato.
+static NodoSaltos *lista_saltos_buscar_anteriores(ListaSaltos *lista, int dato,
+                                                  NodoSaltos **anteriores) {
+    NodoSaltos *anterior = NULL;
+    for (int i = lista->nivel - 1; i >= 0; i--) {
+        NodoSaltos *siguiente = *enlace(lista, anterior, i);
+        while (siguiente != NULL && siguiente->dato < dato) {
+            anterior = siguiente;
+            siguiente = siguiente->siguientes[i];
+        }
+        anteriores[i] = anterior;
+    }
+    return *enlace(lista, anterior, 0);
+}
+
+// Primer nodo con dato >= desde, sin registrar los anteriores
+static const NodoSaltos *lista_saltos_primero_desde(const ListaSaltos *lista,
+                                                    int desde) {
+    const NodoSaltos *anterior = NULL;
+    for (int i = lista->nivel - 1; i >= 0; i--) {
+        const NodoSaltos *siguiente = anterior == NULL ? lista->cabeza[i]
+                                                       : anterior->siguientes[i];
+        while (siguiente != NULL && siguiente->dato < desde) {
+            anterior = siguiente;
+            siguiente = siguiente->siguientes[i];
+        }
+    }
+    return anterior == NULL ? lista->cabeza[0] : anterior->siguientes[0];
+}
+
+// Verifica si dato está en la lista
+bool lista_saltos_contiene(const ListaSaltos *lista, int dato) {
+    const NodoSaltos *nodo = lista_saltos_primero_desde(lista, dato);
+    return nodo != NULL && nodo->dato == dato;
+}
+
+// Inserta dato en su lugar; retorna false si ya estaba o no hay memoria
+bool lista_saltos_insertar(ListaSaltos *lista, int dato) {
+    NodoSaltos *anteriores[MAXIMO_NIVEL];
+    NodoSaltos *encontrado = lista_saltos_buscar_anteriores(lista, dato,
+                                                            anteriores);
+    if (encontrado != NULL && encontrado->dato == dato) {
+        return false;
+    }
+    
+    int nivel = lista_saltos_sortear_nivel(lista);
+    NodoSaltos *nuevo = malloc(sizeof(NodoSaltos) +
+                               nivel * sizeof(NodoSaltos *));
+    if (nuevo == NULL) {
+        return false;
+    }
+    nuevo->dato = dato;
+    nuevo->nivel = nivel;
+    
+    // Los niveles nuevos arrancan desde la cabeza
+    for (int i = lista->nivel; i < nivel; i++) {
+        anteriores[i] = NULL;
+    }
+    if (nivel > lista->nivel) {
+        lista->nivel = nivel;
+    }
+    
+    for (int i = 0; i < nivel; i++) {
+        NodoSaltos **entrante = enlace(lista, anteriores[i], i);
+        nuevo->siguientes[i] = *entrante;
+        *entrante = nuevo;
+    }
+    lista->longitud++;
+    return true;
+}
+
+// Elimina dato; retorna false si no estaba
+bool lista_saltos_eliminar(ListaSaltos *lista, int dato) {
+    NodoSaltos *anteriores[MAXIMO_NIVEL];
+    NodoSaltos *nodo = lista_saltos_buscar_anteriores(lista, dato, anteriores);
+    if (nodo == NULL || nodo->dato != dato) {
+        return false;
+    }
+    
+    for (int i = 0; i < nodo->nivel; i++) {
+        *enlace(lista, anteriores[i], i) = nodo->siguientes[i];
+    }
+    free(nodo);
+    
+    while (lista->nivel > 1 && lista->cabeza[lista->nivel - 1] == NULL) {
+        lista->nivel--;
+    }
+    lista->longitud--;
+    return true;
+}
+
+// Iterador sobre los elementos en [desde, hasta], de menor a mayor
+IteradorRango lista_saltos_rango(const ListaSaltos *lista, int desde,
+                                 int hasta) {
+    IteradorRango iterador = {lista_saltos_primero_desde(lista, desde), hasta};
+    return iterador;
+}
+
+// Indica si quedan elementos del rango por recorrer
+bool iterador_hay_siguiente(const IteradorRango *iterador) {
+    return iterador->nodo != NULL && iterador->nodo->dato <= iterador->hasta;
+}
+
+// Retorna el elemento actual y avanza; requiere iterador_hay_siguiente
+int iterador_siguiente(IteradorRango *iterador) {
+    int dato = iterador->nodo->dato;
+    iterador->nodo = iterador->nodo->siguientes[0];
+    return dato;
+}
+
+// Imprime la lista en orden
+void lista_saltos_imprimir(const ListaSaltos *lista) {
+    Escritor escritor;
+    escritor_iniciar(&escritor, stdout);
+    escritor_cadena(&escritor, "Lista por saltos: ");
+    const NodoSaltos *actual = lista->cabeza[0];
+    while (actual != NULL) {
+        escritor_entero(&escritor, actual->dato);
+        escritor_cadena(&escritor, " ");
+        actual = actual->siguientes[0];
+    }
+    escritor_cadena(&escritor, "(longitud: ");
+    escritor_entero(&escritor, lista->longitud);
+    escritor_cadena(&escritor, ", niveles: ");
+    escritor_entero(&escritor, lista->nivel);
+    escritor_cadena(&escritor, ")\n");
+    escritor_vaciar(&escritor);
+}
+
+// Destruye la lista recorriendo el nivel 0; con NULL no hace nada
+void lista_saltos_destruir(ListaSaltos *lista) {
+    if (lista == NULL) {
+        return;
+    }
+    NodoSaltos *actual = lista->cabeza[0];
+    while (actual != NULL) {
+        NodoSaltos *siguiente = actual->siguientes[0];
+        free(actual);
+        actual = siguiente;
+    }
+    free(lista);
+}
+
+// Referencia para el benchmark: arreglo ordenado (una Secuencia que se
+// mantiene en orden) con búsqueda binaria. Insertar y eliminar corren los
+// elementos de atrás con memmove.
+typedef struct {
+    int *elementos;
+    int longitud;
+} ArregloOrdenado;
+
+// Posición del primer elemento >= dato
+static int arreglo_posicion(const ArregloOrdenado *arreglo, int dato) {
+    int izquierda = 0;
+    int derecha = arreglo->longitud;
+    while (izquierda < derecha) {
+        int medio = izquierda + (derecha - izquierda) / 2;
+        if (arreglo->elementos[medio] < dato) {
+            izquierda = medio + 1;
+        } else {
+            derecha = medio;
+        }
+    }
+    return izquierda;
+}
+
+static bool arreglo_contiene(const ArregloOrdenado *arreglo, int dato) {
+    int posicion = arreglo_posicion(arreglo, dato);
+    return posicion < arreglo->longitud &&
+           arreglo->elementos[posicion] == dato;
+}
+
+// Hay que haber reservado lugar para un elemento más
+static bool arreglo_insertar(ArregloOrdenado *arreglo, int dato) {
+    int posicion = arreglo_posicion(arreglo, dato);
+    if (posicion < arreglo->longitud && arreglo->elementos[posicion] == dato) {
+        return false;
+    }
+    memmove(arreglo->elementos + posicion + 1, arreglo->elementos + posicion,
+            (arreglo->longitud - posicion) * sizeof(int));
+    arreglo->elementos[posicion] = dato;
+    arreglo->longitud++;
+    return true;
+}
+
+static bool arreglo_eliminar(ArregloOrdenado *arreglo, int dato) {
+    int posicion = arreglo_posicion(arreglo, dato);
+    if (posicion == arreglo->longitud || arreglo->elementos[posicion] != dato) {
+        return false;
+    }
+    memmove(arreglo->elementos + posicion, arreglo->elementos + posicion + 1,
+            (arreglo->longitud - posicion - 1) * sizeof(int));
+    arreglo->longitud--;
+    return true;
+}
+
+// Referencia para el benchmark: la Lista de lista_enlazada.c, que solo se
+// puede buscar de punta a punta
+typedef struct {
+    Nodo *cabeza;
+    PoolNodos pool;
+} ListaSimple;
+
+static bool lista_simple_contiene(const ListaSimple *lista, int dato) {
+    for (const Nodo *actual = lista->cabeza; actual != NULL;
+         actual = actual->siguiente) {
+        if (actual->dato == dato) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static double segundos_desde(clock_t inicio) {
+    return (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// Claves pseudoaleatorias reproducibles
+static int clave(uint32_t i) {
+    uint32_t x = i * 2654435761u;
+    x ^= x >> 15;
+    return (int)(x & 0x3fffffff);
+}
+
+static int comparar_enteros(const void *a, const void *b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Con n elementos: millones de búsquedas por segundo en las tres
+// estructuras, millones de elementos por segundo al recorrer rangos de
+// unos 100 elementos, y millones de pares insertar + eliminar por segundo
+// en la lista por saltos y en el arreglo ordenado
+static void benchmark_tamano(int n) {
+    ListaSaltos *saltos = lista_saltos_crear();
+    ArregloOrdenado arreglo;
+    arreglo.elementos = malloc((n + 1) * sizeof(int));
+    arreglo.longitud = 0;
+    ListaSimple simple;
+    simple.cabeza = NULL;
+    pool_iniciar(&simple.pool);
+    if (saltos == NULL || arreglo.elementos == NULL) {
+        fprintf(stderr, "No hay memoria para el benchmark\n");
+        lista_saltos_destruir(saltos);
+        free(arreglo.elementos);
+        return;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        int dato = clave(i);
+        if (lista_saltos_insertar(saltos, dato)) {
+            arreglo.elementos[arreglo.longitud] = dato;
+            arreglo.longitud++;
+            Nodo *nodo = pool_obtener(&simple.pool);
+            if (nodo == NULL) {
+                fprintf(stderr, "No hay memoria para el benchmark\n");
+                lista_saltos_destruir(saltos);
+                free(arreglo.elementos);
+                pool_liberar_todo(&simple.pool);
+                return;
+            }
+            nodo->dato = dato;
+            nodo->siguiente = simple.cabeza;
+            simple.cabeza = nodo;
+        }
+    }
+    qsort(arreglo.elementos, arreglo.longitud, sizeof(int), comparar_enteros);
+    
+    // Búsquedas: la mitad de las claves están, la mitad no
+    int consultas = 1000000;
+    int consultas_lineal = 100000000 / n;
+    if (consultas_lineal > consultas) {
+        consultas_lineal = consultas;
+    }
+    volatile int encontrados = 0;
+    clock_t inicio = clock();
+    for (int i = 0; i < consultas; i++) {
+        encontrados += lista_saltos_contiene(saltos, clave(i % (2 * n)));
+    }
+    double buscar_saltos = consultas / segundos_desde(inicio) / 1e6;
+    inicio = clock();
+    for (int i = 0; i < consultas; i++) {
+        encontrados += arreglo_contiene(&arreglo, clave(i % (2 * n)));
+    }
+    double buscar_binaria = consultas / segundos_desde(inicio) / 1e6;
+    inicio = clock();
+    for (int i = 0; i < consultas_lineal; i++) {
+        encontrados += lista_simple_contiene(&simple, clave(i % (2 * n)));
+    }
+    double buscar_lineal = consultas_lineal / segundos_desde(inicio) / 1e6;
+    
+    // Rangos de 100 elementos desde claves al azar
+    int rangos = 100000;
+    long long suma_saltos = 0;
+    long long suma_arreglo = 0;
+    long long recorridos = 0;
+    int ancho = (int)(100.0 * 0x40000000 / n);
+    inicio = clock();
+    for (int i = 0; i < rangos; i++) {
+        int desde = clave(3 * i + 1);
+        IteradorRango iterador = lista_saltos_rango(saltos, desde,
+                                                    desde + ancho);
+        while (iterador_hay_siguiente(&iterador)) {
+            suma_saltos += iterador_siguiente(&iterador);
+            recorridos++;
+        }
+    }
+    double rango_saltos = recorridos / segundos_desde(inicio) / 1e6;
+    inicio = clock();
+    for (int i = 0; i < rangos; i++) {
+        int desde = clave(3 * i + 1);
+        for (int j = arreglo_posicion(&arreglo, desde);
+             j < arreglo.longitud && arreglo.elementos[j] <= desde + ancho;
+             j++) {
+            suma_arreglo += arreglo.elementos[j];
+        }
+    }
+    double rango_arreglo = recorridos / segundos_desde(inicio) / 1e6;
+    
+    // Actualizaciones: se inserta una clave nueva y se elimina una vieja
+    int cambios = 200000;
+    int cambios_arreglo = 2000000000 / n / 10;
+    if (cambios_arreglo > cambios) {
+        cambios_arreglo = cambios;
+    }
+    inicio = clock();
+    for (int i = 0; i < cambios; i++) {
+        lista_saltos_insertar(saltos, clave(n + i));
+        lista_saltos_eliminar(saltos, clave(i));
+    }
+    double cambiar_saltos = cambios / segundos_desde(inicio) / 1e6;
+    inicio = clock();
+    for (int i = 0; i < cambios_arreglo; i++) {
+        arreglo_insertar(&arreglo, clave(n + i));
+        arreglo_eliminar(&arreglo, clave(i));
+    }
+    double cambiar_arreglo = cambios_arreglo / segundos_desde(inicio) / 1e6;
+    
+    printf("%9d %8.2f %8.2f %8.4f %9.2f %9.4f %8.1f %8.1f%s\n", n,
+           buscar_saltos, buscar_binaria, buscar_lineal, cambiar_saltos,
+           cambiar_arreglo, rango_saltos, rango_arreglo,
+           suma_saltos == suma_arreglo ? "" : " (¡rangos distintos!)");
+    
+    lista_saltos_destruir(saltos);
+    free(arreglo.elementos);
+    pool_liberar_todo(&simple.pool);
+}
+
+// Compara la lista por saltos con un arreglo ordenado con búsqueda binaria
+// y con la búsqueda lineal de una Lista
+static int benchmark(void) {
+    printf("M operaciones/s (rango: M elementos recorridos/s)\n");
+    printf("%9s %8s %8s %8s %9s %9s %8s %8s\n", "", "buscar", "buscar",
+           "buscar", "ins+elim", "ins+elim", "rango", "rango");
+    printf("%9s %8s %8s %8s %9s %9s %8s %8s\n", "elementos", "saltos",
+           "binaria", "lineal", "saltos", "arreglo", "saltos", "arreglo");
+    for (int n = 1000; n <= 1000000; n *= 10) {
+        benchmark_tamano(n);
+    }
+    return 0;
+}
+
+static int demostracion(void) {
+    ListaSaltos *lista = lista_saltos_crear();
+    if (lista == NULL) {
+        fprintf(stderr, "Error al crear la lista\n");
+        return 1;
+    }
+    
+    printf("Insertando: 30 10 50 20 40 10\n");
+    int datos[] = {30, 10, 50, 20, 40, 10};
+    for (int i = 0; i < 6; i++) {
+        if (!lista_saltos_insertar(lista, datos[i])) {
+            printf("%d ya estaba\n", datos[i]);
+        }
+    }
+    lista_saltos_imprimir(lista);
+    
+    printf("\n¿Contiene 20? %s\n", lista_saltos_contiene(lista, 20) ? "sí" : "no");
+    printf("¿Contiene 25? %s\n", lista_saltos_contiene(lista, 25) ? "sí" : "no");
+    
+    printf("\nElementos entre 15 y 45:");
+    IteradorRango iterador = lista_saltos_rango(lista, 15, 45);
+    while (iterador_hay_siguiente(&iterador)) {
+        printf(" %d", iterador_siguiente(&iterador));
+    }
+    printf("\n");
+    
+    printf("\nEliminando 30\n");
+    lista_saltos_eliminar(lista, 30);
+    lista_saltos_imprimir(lista);
+    
+    lista_saltos_destruir(lista);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        return demostracion();
+    }
+    
+    if (strcmp(argv[1], "benchmark") == 0) {
+        return benchmark();
+    }
+    
+    printf("Uso: %s [benchmark]\n", argv[0]);
+    return 1;
+}
@@ -1,17 +1,140 @@
-// TAD Pila (Stack) - Implementación con lista enlazada
+// TAD Pila (Stack) - Implementación con lista enlazada o con arreglo
+//
+// La implementación se elige al compilar; las funciones pila_* son las
+// mismas en ambos casos:
+//     gcc pila.c                  -> lista enlazada de nodos
+//     gcc -DPILA_ARREGLO pila.c   -> arreglo contiguo que crece
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+#include <time.h>
 
-typedef struct Nodo {
-    int dato;
-    struct Nodo *siguiente;
-} Nodo;
+#include "escritor.h"
+
+#ifdef PILA_ARREGLO
+
+// Elementos que entran en la propia Pila antes de usar memoria dinámica
+#define CAPACIDAD_EN_LINEA 16
 
+// Los primeros CAPACIDAD_EN_LINEA elementos viven en buffer, dentro de la
+// Pila: una pila poco profunda nunca pide memoria para sus elementos.
+// Al llenarse, elementos pasa a un arreglo dinámico que se duplica.
+typedef struct {
+    int *elementos;   // Apunta a buffer o al arreglo dinámico
+    int tamano;
+    int capacidad;
+    int buffer[CAPACIDAD_EN_LINEA];
+} Pila;
+
+// Crea una pila vacía
+Pila *pila_crear(void) {
+    Pila *pila = malloc(sizeof(Pila));
+    if (pila == NULL) {
+        return NULL;
+    }
+    pila->elementos = pila->buffer;
+    pila->tamano = 0;
+    pila->capacidad = CAPACIDAD_EN_LINEA;
+    return pila;
+}
+
+// Verifica si la pila está vacía
+bool pila_vacia(const Pila *pila) {
+    return pila->tamano == 0;
+}
+
+// Retorna el tamaño de la pila
+int pila_tamano(const Pila *pila) {
+    return pila->tamano;
+}
+
+// Duplica la capacidad; la primera vez copia el buffer en línea al heap
+static bool pila_redimensionar(Pila *pila) {
+    int nueva_capacidad = pila->capacidad * 2;
+    int *nuevos_elementos;
+    if (pila->elementos == pila->buffer) {
+        nuevos_elementos = malloc(nueva_capacidad * sizeof(int));
+        if (nuevos_elementos != NULL) {
+            memcpy(nuevos_elementos, pila->buffer, sizeof(pila->buffer));
+        }
+    } else {
+        nuevos_elementos = realloc(pila->elementos,
+                                   nueva_capacidad * sizeof(int));
+    }
+    
+    if (nuevos_elementos == NULL) {
+        return false;
+    }
+    pila->elementos = nuevos_elementos;
+    pila->capacidad = nueva_capacidad;
+    return true;
+}
+
+// Apila un elemento (push)
+bool pila_apilar(Pila *pila, int dato) {
+    if (pila->tamano >= pila->capacidad) {
+        if (!pila_redimensionar(pila)) {
+            return false;
+        }
+    }
+    pila->elementos[pila->tamano] = dato;
+    pila->tamano++;
+    return true;
+}
+
+// Desapila un elemento (pop)
+bool pila_desapilar(Pila *pila, int *dato) {
+    if (pila_vacia(pila)) {
+        return false;
+    }
+    pila->tamano--;
+    *dato = pila->elementos[pila->tamano];
+    return true;
+}
+
+// Ve el elemento en el tope sin desapilar (peek)
+bool pila_tope(const Pila *pila, int *dato) {
+    if (pila_vacia(pila)) {
+        return false;
+    }
+    *dato = pila->elementos[pila->tamano - 1];
+    return true;
+}
+
+// Destruye la pila
+void pila_destruir(Pila *pila) {
+    if (pila->elementos != pila->buffer) {
+        free(pila->elementos);
+    }
+    free(pila);
+}
+
+// Imprime la pila
+void pila_imprimir(const Pila *pila) {
+    Escritor escritor;
+    escritor_iniciar(&escritor, stdout);
+    escritor_cadena(&escritor, "Pila (tope -> base): ");
+    for (int i = pila->tamano - 1; i >= 0; i--) {
+        escritor_entero(&escritor, pila->elementos[i]);
+        escritor_cadena(&escritor, " ");
+    }
+    escritor_cadena(&escritor, "(tamaño: ");
+    escritor_entero(&escritor, pila->tamano);
+    escritor_cadena(&escritor, ")\n");
+    escritor_vaciar(&escritor);
+}
+
+#else
+
+#include "pool_nodos.h"
+
+// Los nodos salen de un pool propio en lugar de un malloc por nodo
 typedef struct {
     Nodo *tope;
     int tamano;
+    PoolNodos pool;
 } Pila;
 
 // Crea una pila vacía
@@ -22,6 +145,7 @@ Pila *pila_crear(void) {
     }
     pila->tope = NULL;
     pila->tamano = 0;
+    pool_iniciar(&pila->pool);
     return pila;
 }
 
@@ -37,7 +161,7 @@ int pila_tamano(const Pila *pila) {
 
 // Apila un elemento (push)
 bool pila_apilar(Pila *pila, int dato) {
-    Nodo *nuevo = malloc(sizeof(Nodo));
+    Nodo *nuevo = pool_obtener(&pila->pool);
     if (nuevo == NULL) {
         return false;
     }
@@ -58,7 +182,7 @@ bool pila_desapilar(Pila *pila, int *dato) {
     Nodo *a_eliminar = pila->tope;
     *dato = a_eliminar->dato;
     pila->tope = pila->tope->siguiente;
-    free(a_eliminar);
+    pool_devolver(&pila->pool, a_eliminar);
     pila->tamano--;
     return true;
 }
@@ -73,26 +197,77 @@ bool pila_tope(const Pila *pila, int *dato) {
 }
 
 // Destruye la pila
+// Libera los slabs del pool de una vez, sin desapilar nodo por nodo
 void pila_destruir(Pila *pila) {
-    while (!pila_vacia(pila)) {
-        int dato;
-        pila_desapilar(pila, &dato);
-    }
+    pool_liberar_todo(&pila->pool);
     free(pila);
 }
 
 // Imprime la pila
 void pila_imprimir(const Pila *pila) {
-    printf("Pila (tope -> base): ");
+    Escritor escritor;
+    escritor_iniciar(&escritor, stdout);
+    escritor_cadena(&escritor, "Pila (tope -> base): ");
     Nodo *actual = pila->tope;
     while (actual != NULL) {
-        printf("%d ", actual->dato);
+        escritor_entero(&escritor, actual->dato);
+        escritor_cadena(&escritor, " ");
         actual = actual->siguiente;
     }
-    printf("(tamaño: %d)\n", pila->tamano);
+    escritor_cadena(&escritor, "(tamaño: ");
+    escritor_entero(&escritor, pila->tamano);
+    escritor_cadena(&escritor, ")\n");
+    escritor_vaciar(&escritor);
+}
+
+#endif // PILA_ARREGLO
+
+// Apila y desapila en ciclos de profundidad fija y retorna millones de
+// operaciones (apilar + desapilar) por segundo
+static double medir_ciclos(int profundidad, int ciclos) {
+    Pila *pila = pila_crear();
+    if (pila == NULL) {
+        return 0.0;
+    }
+    volatile long long sumidero = 0;
+    clock_t inicio = clock();
+    for (int c = 0; c < ciclos; c++) {
+        for (int i = 0; i < profundidad; i++) {
+            pila_apilar(pila, i);
+        }
+        for (int i = 0; i < profundidad; i++) {
+            int dato = 0;
+            pila_desapilar(pila, &dato);
+            sumidero += dato;
+        }
+    }
+    double segundos = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    pila_destruir(pila);
+    return 2.0 * profundidad * ciclos / segundos / 1e6;
 }
 
-int main(void) {
+// Mide el rendimiento de la implementación compilada con pilas poco
+// profundas (entran en el buffer en línea) y profundas
+static int benchmark(void) {
+#ifdef PILA_ARREGLO
+    printf("Implementación: arreglo\n");
+#else
+    printf("Implementación: lista enlazada\n");
+#endif
+    printf("%12s %14s\n", "profundidad", "M ops/s");
+    int profundidades[] = {8, 1000, 1000000, 10000000};
+    for (int i = 0; i < 4; i++) {
+        int ciclos = 50000000 / profundidades[i];
+        if (ciclos < 2) {
+            ciclos = 2;
+        }
+        printf("%12d %14.1f\n", profundidades[i],
+               medir_ciclos(profundidades[i], ciclos));
+    }
+    return 0;
+}
+
+static int demostracion(void) {
     Pila *mi_pila = pila_crear();
     if (mi_pila == NULL) {
         fprintf(stderr, "Error al crear la pila\n");
@@ -126,3 +301,16 @@ int main(void) {
     pila_destruir(mi_pila);
     return 0;
 }
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        return demostracion();
+    }
+    
+    if (strcmp(argv[1], "benchmark") == 0) {
+        return benchmark();
+    }
+    
+    printf("Uso: %s [benchmark]\n", argv[0]);
+    return 1;
+}
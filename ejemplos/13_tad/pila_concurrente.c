@@ -0,0 +1,453 @@
+// TAD Pila (Stack) - Implementación concurrente sin bloqueos (Treiber)
+//
+// Varios hilos pueden apilar y desapilar a la vez sin mutex: cada
+// operación lee el tope, prepara el cambio y lo publica con una
+// comparación e intercambio atómica (CAS) de C11. Si otro hilo cambió el
+// tope en el medio, el CAS falla y se reintenta.
+//
+// Problema ABA: un hilo lee el tope A, otro desapila A y B y vuelve a
+// apilar A; el CAS del primero vería "A" y tendría éxito con un siguiente
+// viejo. Para evitarlo el tope no es un puntero sino un índice de 32 bits
+// más una etiqueta de 32 bits que se incrementa en cada cambio, todo en un
+// uint64_t: así alcanza con un CAS de 64 bits.
+//
+// Los nodos salen de un arreglo reservado al crear la pila y se reciclan a
+// través de una segunda pila de nodos libres con el mismo esquema. Como
+// nunca se liberan mientras la pila existe, leer un nodo que otro hilo
+// acaba de desapilar es seguro: a lo sumo el CAS falla.
+//
+// Compilar con: gcc -Wall -Wextra -std=c11 -pedantic -pthread pila_concurrente.c
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+
+// Índice que marca el fin de una pila
+#define SIN_NODO UINT32_MAX
+
+#define OPERACIONES_POR_HILO 2000000
+#define MAXIMO_HILOS 64
+
+typedef struct {
+    int dato;
+    _Atomic uint32_t siguiente;  // Índice del nodo de abajo
+} NodoConcurrente;
+
+typedef struct {
+    _Atomic uint64_t tope;      // (etiqueta << 32) | índice
+    _Atomic uint64_t libres;    // Nodos disponibles, mismo formato
+    NodoConcurrente *nodos;
+    uint32_t capacidad;
+} Pila;
+
+static uint32_t indice_de(uint64_t cabeza) {
+    return (uint32_t)cabeza;
+}
+
+// Arma una cabeza nueva apuntando a indice con la etiqueta incrementada
+static uint64_t cabeza_siguiente(uint64_t anterior, uint32_t indice) {
+    uint64_t etiqueta = (anterior >> 32) + 1;
+    return (etiqueta << 32) | indice;
+}
+
+// Apila el nodo indice sobre la pila cuya cabeza es cabeza
+static void apilar_indice(_Atomic uint64_t *cabeza, NodoConcurrente *nodos,
+                          uint32_t indice) {
+    uint64_t anterior = atomic_load_explicit(cabeza, memory_order_relaxed);
+    uint64_t nueva;
+    do {
+        atomic_store_explicit(&nodos[indice].siguiente, indice_de(anterior),
+                              memory_order_relaxed);
+        nueva = cabeza_siguiente(anterior, indice);
+        // release: quien desapile este nodo ve su dato ya escrito
+    } while (!atomic_compare_exchange_weak_explicit(
+                 cabeza, &anterior, nueva,
+                 memory_order_release, memory_order_relaxed));
+}
+
+// Desapila un nodo y retorna su índice, o SIN_NODO si la pila está vacía
+static uint32_t desapilar_indice(_Atomic uint64_t *cabeza,
+                                 NodoConcurrente *nodos) {
+    uint64_t anterior = atomic_load_explicit(cabeza, memory_order_acquire);
+    uint64_t nueva;
+    uint32_t indice;
+    do {
+        indice = indice_de(anterior);
+        if (indice == SIN_NODO) {
+            return SIN_NODO;
+        }
+        // El nodo puede estar cambiando en otro hilo; si es así, la
+        // etiqueta de la cabeza también cambió y el CAS va a fallar
+        uint32_t siguiente = atomic_load_explicit(&nodos[indice].siguiente,
+                                                  memory_order_relaxed);
+        nueva = cabeza_siguiente(anterior, siguiente);
+    } while (!atomic_compare_exchange_weak_explicit(
+                 cabeza, &anterior, nueva,
+                 memory_order_acquire, memory_order_acquire));
+    return indice;
+}
+
+// Crea una pila vacía con lugar para capacidad elementos
+// Retorna NULL si no hay memoria o la capacidad no es válida
+Pila *pila_crear(uint32_t capacidad) {
+    if (capacidad == 0 || capacidad >= SIN_NODO) {
+        return NULL;
+    }
+    Pila *pila = malloc(sizeof(Pila));
+    if (pila == NULL) {
+        return NULL;
+    }
+    pila->nodos = malloc(capacidad * sizeof(NodoConcurrente));
+    if (pila->nodos == NULL) {
+        free(pila);
+        return NULL;
+    }
+    
+    pila->capacidad = capacidad;
+    // Todos los nodos arrancan encadenados en la pila de libres
+    for (uint32_t i = 0; i < capacidad; i++) {
+        uint32_t siguiente = SIN_NODO;
+        if (i + 1 < capacidad) {
+            siguiente = i + 1;
+        }
+        atomic_init(&pila->nodos[i].siguiente, siguiente);
+    }
+    atomic_init(&pila->libres, (uint64_t)0);
+    atomic_init(&pila->tope, (uint64_t)SIN_NODO);
+    return pila;
+}
+
+// Destruye la pila; ningún otro hilo debe estar usándola
+void pila_destruir(Pila *pila) {
+    if (pila != NULL) {
+        free(pila->nodos);
+        free(pila);
+    }
+}
+
+// Apila un elemento (push); retorna false si la pila está llena
+bool pila_apilar(Pila *pila, int dato) {
+    uint32_t indice = desapilar_indice(&pila->libres, pila->nodos);
+    if (indice == SIN_NODO) {
+        return false;
+    }
+    pila->nodos[indice].dato = dato;
+    apilar_indice(&pila->tope, pila->nodos, indice);
+    return true;
+}
+
+// Desapila un elemento (pop); retorna false si la pila está vacía
+bool pila_desapilar(Pila *pila, int *dato) {
+    uint32_t indice = desapilar_indice(&pila->tope, pila->nodos);
+    if (indice == SIN_NODO) {
+        return false;
+    }
+    *dato = pila->nodos[indice].dato;
+    apilar_indice(&pila->libres, pila->nodos, indice);
+    return true;
+}
+
+// Verifica si la pila está vacía (puede cambiar apenas retorna)
+bool pila_vacia(const Pila *pila) {
+    uint64_t tope = atomic_load_explicit(&pila->tope, memory_order_acquire);
+    return indice_de(tope) == SIN_NODO;
+}
+
+// Referencia para el benchmark: pila con arreglo protegida por un mutex
+typedef struct {
+    pthread_mutex_t candado;
+    int *elementos;
+    int tamano;
+    int capacidad;
+} PilaConMutex;
+
+static bool pila_mutex_apilar(PilaConMutex *pila, int dato) {
+    bool ok = false;
+    pthread_mutex_lock(&pila->candado);
+    if (pila->tamano < pila->capacidad) {
+        pila->elementos[pila->tamano] = dato;
+        pila->tamano++;
+        ok = true;
+    }
+    pthread_mutex_unlock(&pila->candado);
+    return ok;
+}
+
+static bool pila_mutex_desapilar(PilaConMutex *pila, int *dato) {
+    bool ok = false;
+    pthread_mutex_lock(&pila->candado);
+    if (pila->tamano > 0) {
+        pila->tamano--;
+        *dato = pila->elementos[pila->tamano];
+        ok = true;
+    }
+    pthread_mutex_unlock(&pila->candado);
+    return ok;
+}
+
+// Lo que recibe cada hilo de la prueba de estrés y del benchmark
+typedef struct {
+    Pila *pila;
+    PilaConMutex *pila_mutex;
+    int primer_valor;
+    int operaciones;
+    _Atomic int *vistos;        // Veces que salió cada valor (estrés)
+    pthread_barrier_t *largada;
+} Trabajo;
+
+static void registrar(_Atomic int *vistos, int valor) {
+    atomic_fetch_add_explicit(&vistos[valor], 1, memory_order_relaxed);
+}
+
+// Apila valores propios del hilo y desapila lo que encuentre, anotando
+// cada valor que sale
+static void *hilo_estres(void *argumento) {
+    Trabajo *trabajo = argumento;
+    pthread_barrier_wait(trabajo->largada);
+    for (int i = 0; i < trabajo->operaciones; i++) {
+        int valor = trabajo->primer_valor + i;
+        while (!pila_apilar(trabajo->pila, valor)) {
+            // Llena: se hace lugar desapilando
+            int dato;
+            if (pila_desapilar(trabajo->pila, &dato)) {
+                registrar(trabajo->vistos, dato);
+            }
+        }
+        // Cada tanto se desapilan dos para variar la profundidad
+        int extraidos = 1 + (i % 3 == 0);
+        for (int k = 0; k < extraidos; k++) {
+            int dato;
+            if (pila_desapilar(trabajo->pila, &dato)) {
+                registrar(trabajo->vistos, dato);
+            }
+        }
+    }
+    return NULL;
+}
+
+// Varios hilos apilan y desapilan a la vez; al final cada valor apilado
+// tiene que haber salido exactamente una vez
+static int prueba_estres(int hilos, int operaciones) {
+    int total = hilos * operaciones;
+    Pila *pila = pila_crear(1024);
+    _Atomic int *vistos = calloc(total, sizeof(_Atomic int));
+    pthread_t *ids = malloc(hilos * sizeof(pthread_t));
+    Trabajo *trabajos = malloc(hilos * sizeof(Trabajo));
+    if (pila == NULL || vistos == NULL || ids == NULL || trabajos == NULL) {
+        fprintf(stderr, "No hay memoria para la prueba\n");
+        pila_destruir(pila);
+        free(vistos);
+        free(ids);
+        free(trabajos);
+        return 1;
+    }
+    
+    pthread_barrier_t largada;
+    pthread_barrier_init(&largada, NULL, hilos);
+    for (int h = 0; h < hilos; h++) {
+        trabajos[h].pila = pila;
+        trabajos[h].pila_mutex = NULL;
+        trabajos[h].primer_valor = h * operaciones;
+        trabajos[h].operaciones = operaciones;
+        trabajos[h].vistos = vistos;
+        trabajos[h].largada = &largada;
+        pthread_create(&ids[h], NULL, hilo_estres, &trabajos[h]);
+    }
+    for (int h = 0; h < hilos; h++) {
+        pthread_join(ids[h], NULL);
+    }
+    pthread_barrier_destroy(&largada);
+    
+    int dato;
+    while (pila_desapilar(pila, &dato)) {
+        registrar(vistos, dato);
+    }
+    
+    int perdidos = 0;
+    int repetidos = 0;
+    for (int i = 0; i < total; i++) {
+        int veces = atomic_load(&vistos[i]);
+        if (veces == 0) {
+            perdidos++;
+        } else if (veces > 1) {
+            repetidos++;
+        }
+    }
+    printf("%d hilos, %d valores: %d perdidos, %d repetidos -> %s\n",
+           hilos, total, perdidos, repetidos,
+           perdidos == 0 && repetidos == 0 ? "OK" : "ERROR");
+    
+    pila_destruir(pila);
+    free(vistos);
+    free(ids);
+    free(trabajos);
+    return perdidos == 0 && repetidos == 0 ? 0 : 1;
+}
+
+static void *hilo_benchmark_sin_bloqueo(void *argumento) {
+    Trabajo *trabajo = argumento;
+    pthread_barrier_wait(trabajo->largada);
+    for (int i = 0; i < trabajo->operaciones; i++) {
+        int dato;
+        pila_apilar(trabajo->pila, i);
+        pila_desapilar(trabajo->pila, &dato);
+    }
+    return NULL;
+}
+
+static void *hilo_benchmark_mutex(void *argumento) {
+    Trabajo *trabajo = argumento;
+    pthread_barrier_wait(trabajo->largada);
+    for (int i = 0; i < trabajo->operaciones; i++) {
+        int dato;
+        pila_mutex_apilar(trabajo->pila_mutex, i);
+        pila_mutex_desapilar(trabajo->pila_mutex, &dato);
+    }
+    return NULL;
+}
+
+static double segundos_ahora(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Corre hilos que apilan y desapilan operaciones veces cada uno y retorna
+// millones de operaciones por segundo
+static double medir(void *(*funcion)(void *), Pila *pila,
+                    PilaConMutex *pila_mutex, int hilos, int operaciones) {
+    pthread_t ids[MAXIMO_HILOS];
+    Trabajo trabajos[MAXIMO_HILOS];
+    pthread_barrier_t largada;
+    // El hilo principal también pasa por la barrera para tomar el tiempo
+    pthread_barrier_init(&largada, NULL, hilos + 1);
+    for (int h = 0; h < hilos; h++) {
+        trabajos[h].pila = pila;
+        trabajos[h].pila_mutex = pila_mutex;
+        trabajos[h].primer_valor = 0;
+        trabajos[h].operaciones = operaciones;
+        trabajos[h].vistos = NULL;
+        trabajos[h].largada = &largada;
+        pthread_create(&ids[h], NULL, funcion, &trabajos[h]);
+    }
+    pthread_barrier_wait(&largada);
+    double inicio = segundos_ahora();
+    for (int h = 0; h < hilos; h++) {
+        pthread_join(ids[h], NULL);
+    }
+    double segundos = segundos_ahora() - inicio;
+    pthread_barrier_destroy(&largada);
+    return 2.0 * hilos * operaciones / segundos / 1e6;
+}
+
+// Cantidades de hilos del escalado: 1, 2, 4... y siempre maximo al final
+static int siguiente_cantidad_hilos(int hilos, int maximo) {
+    if (hilos < maximo && hilos * 2 > maximo) {
+        return maximo;
+    }
+    return hilos * 2;
+}
+
+// Escalado de 1 a maximo_hilos hilos contra la pila con mutex
+static int benchmark_escalado(int maximo_hilos) {
+    Pila *pila = pila_crear(1024);
+    PilaConMutex pila_mutex;
+    pila_mutex.elementos = malloc(1024 * sizeof(int));
+    pila_mutex.tamano = 0;
+    pila_mutex.capacidad = 1024;
+    if (pila == NULL || pila_mutex.elementos == NULL) {
+        fprintf(stderr, "No hay memoria para el benchmark\n");
+        pila_destruir(pila);
+        free(pila_mutex.elementos);
+        return 1;
+    }
+    pthread_mutex_init(&pila_mutex.candado, NULL);
+    
+    printf("%6s %18s %14s\n", "hilos", "sin bloqueo M/s", "mutex M/s");
+    for (int hilos = 1; hilos <= maximo_hilos;
+         hilos = siguiente_cantidad_hilos(hilos, maximo_hilos)) {
+        int operaciones = OPERACIONES_POR_HILO;
+        double sin_bloqueo = medir(hilo_benchmark_sin_bloqueo, pila, NULL,
+                                   hilos, operaciones);
+        double con_mutex = medir(hilo_benchmark_mutex, NULL, &pila_mutex,
+                                 hilos, operaciones);
+        printf("%6d %18.1f %14.1f\n", hilos, sin_bloqueo, con_mutex);
+    }
+    
+    pthread_mutex_destroy(&pila_mutex.candado);
+    free(pila_mutex.elementos);
+    pila_destruir(pila);
+    return 0;
+}
+
+static int demostracion(void) {
+    Pila *mi_pila = pila_crear(8);
+    if (mi_pila == NULL) {
+        fprintf(stderr, "Error al crear la pila\n");
+        return 1;
+    }
+    
+    printf("Apilando: 10, 20, 30\n");
+    pila_apilar(mi_pila, 10);
+    pila_apilar(mi_pila, 20);
+    pila_apilar(mi_pila, 30);
+    
+    int dato;
+    printf("Desapilando elementos:\n");
+    while (pila_desapilar(mi_pila, &dato)) {
+        printf("Desapilado: %d\n", dato);
+    }
+    
+    pila_destruir(mi_pila);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    long procesadores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (procesadores < 1) {
+        procesadores = 1;
+    }
+    
+    if (argc == 1) {
+        return demostracion();
+    }
+    
+    if (strcmp(argv[1], "estres") == 0) {
+        int hilos = 2 * (int)procesadores;
+        if (hilos < 4) {
+            hilos = 4;
+        }
+        if (argc == 3) {
+            hilos = atoi(argv[2]);
+        }
+        if (hilos <= 0) {
+            fprintf(stderr, "La cantidad de hilos debe ser positiva\n");
+            return 1;
+        }
+        return prueba_estres(hilos, 200000);
+    }
+    
+    if (strcmp(argv[1], "escalado") == 0) {
+        int maximo_hilos = (int)procesadores;
+        if (argc == 3) {
+            maximo_hilos = atoi(argv[2]);
+        }
+        if (maximo_hilos <= 0 || maximo_hilos > MAXIMO_HILOS) {
+            fprintf(stderr, "La cantidad de hilos debe estar entre 1 y %d\n",
+                    MAXIMO_HILOS);
+            return 1;
+        }
+        return benchmark_escalado(maximo_hilos);
+    }
+    
+    printf("Uso: %s [estres [hilos] | escalado [maximo_hilos]]\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,154 @@
+// Pool de nodos compartido por Lista, Pila y Cola
+//
+// En lugar de un malloc por nodo, el pool pide bloques grandes (slabs) y
+// reparte los nodos de a uno. Los nodos devueltos quedan en una lista de
+// libres, enlazados por su propio campo siguiente, y se reutilizan antes de
+// tocar un slab nuevo. Como todos los nodos de una estructura viven en sus
+// slabs, destruirla es liberar los slabs, sin recorrer nodo por nodo.
+//
+// Los slabs empiezan chicos y se duplican hasta NODOS_POR_SLAB_MAXIMO, así
+// una pila de tres elementos no reserva 64 KiB.
+
+#ifndef POOL_NODOS_H
+#define POOL_NODOS_H
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#define NODOS_POR_SLAB_INICIAL 16
+#define NODOS_POR_SLAB_MAXIMO 4096
+
+// Nodo de Lista, Pila y Cola
+typedef struct Nodo {
+    int dato;
+    struct Nodo *siguiente;
+} Nodo;
+
+// Bloque contiguo de nodos
+typedef struct Slab {
+    struct Slab *siguiente;
+    int capacidad;
+    Nodo nodos[];
+} Slab;
+
+typedef struct {
+    Slab *slabs;          // El primero es el slab del que se reparte
+    Slab *ultimo_slab;
+    int entregados;       // Nodos ya repartidos del primer slab
+    Nodo *libres;         // Nodos devueltos, listos para reutilizar
+    Nodo *ultimo_libre;
+} PoolNodos;
+
+// Deja el pool vacío, sin memoria reservada
+static inline void pool_iniciar(PoolNodos *pool) {
+    pool->slabs = NULL;
+    pool->ultimo_slab = NULL;
+    pool->entregados = 0;
+    pool->libres = NULL;
+    pool->ultimo_libre = NULL;
+}
+
+// Agrega un slab nuevo al frente, el doble de grande que el anterior
+static inline bool pool_agregar_slab(PoolNodos *pool) {
+    int capacidad = NODOS_POR_SLAB_INICIAL;
+    if (pool->slabs != NULL) {
+        capacidad = pool->slabs->capacidad * 2;
+        if (capacidad > NODOS_POR_SLAB_MAXIMO) {
+            capacidad = NODOS_POR_SLAB_MAXIMO;
+        }
+    }
+
+    Slab *slab = malloc(sizeof(Slab) + capacidad * sizeof(Nodo));
+    if (slab == NULL) {
+        return false;
+    }
+
+    slab->capacidad = capacidad;
+    slab->siguiente = pool->slabs;
+    pool->slabs = slab;
+    if (pool->ultimo_slab == NULL) {
+        pool->ultimo_slab = slab;
+    }
+    pool->entregados = 0;
+    return true;
+}
+
+// Obtiene un nodo sin inicializar, o NULL si no hay memoria
+static inline Nodo *pool_obtener(PoolNodos *pool) {
+    if (pool->libres != NULL) {
+        Nodo *nodo = pool->libres;
+        pool->libres = nodo->siguiente;
+        if (pool->libres == NULL) {
+            pool->ultimo_libre = NULL;
+        }
+        return nodo;
+    }
+
+    if (pool->slabs == NULL || pool->entregados >= pool->slabs->capacidad) {
+        if (!pool_agregar_slab(pool)) {
+            return NULL;
+        }
+    }
+
+    Nodo *nodo = &pool->slabs->nodos[pool->entregados];
+    pool->entregados++;
+    return nodo;
+}
+
+// Devuelve un nodo al pool para reutilizarlo
+static inline void pool_devolver(PoolNodos *pool, Nodo *nodo) {
+    nodo->siguiente = pool->libres;
+    pool->libres = nodo;
+    if (pool->ultimo_libre == NULL) {
+        pool->ultimo_libre = nodo;
+    }
+}
+
+// Pasa todos los slabs y nodos libres de origen a destino en O(1)
+// Hace falta cuando nodos de una estructura pasan a otra (por ejemplo al
+// concatenar listas), para que sigan vivos al destruir la de origen.
+// El resto sin repartir del slab actual de origen queda sin uso hasta que
+// se liberen los slabs de destino. origen queda vacío.
+static inline void pool_absorber(PoolNodos *destino, PoolNodos *origen) {
+    if (origen->slabs == NULL) {
+        return;
+    }
+
+    if (destino->slabs == NULL) {
+        destino->slabs = origen->slabs;
+        destino->ultimo_slab = origen->ultimo_slab;
+        destino->entregados = origen->entregados;
+    } else {
+        // Se insertan detrás del slab actual de destino, que sigue
+        // repartiendo nodos
+        origen->ultimo_slab->siguiente = destino->slabs->siguiente;
+        destino->slabs->siguiente = origen->slabs;
+        if (destino->ultimo_slab == destino->slabs) {
+            destino->ultimo_slab = origen->ultimo_slab;
+        }
+    }
+
+    if (origen->libres != NULL) {
+        origen->ultimo_libre->siguiente = destino->libres;
+        destino->libres = origen->libres;
+        if (destino->ultimo_libre == NULL) {
+            destino->ultimo_libre = origen->ultimo_libre;
+        }
+    }
+
+    pool_iniciar(origen);
+}
+
+// Libera todos los slabs de una vez; los nodos entregados dejan de ser
+// válidos
+static inline void pool_liberar_todo(PoolNodos *pool) {
+    Slab *actual = pool->slabs;
+    while (actual != NULL) {
+        Slab *siguiente = actual->siguiente;
+        free(actual);
+        actual = siguiente;
+    }
+    pool_iniciar(pool);
+}
+
+#endif // POOL_NODOS_H
@@ -0,0 +1,314 @@
+// Reducciones y búsqueda sobre arreglos de int con SIMD
+//
+// Cada operación tiene tres versiones: escalar, SSE2 (4 int por
+// instrucción) y AVX2 (8 int por instrucción). reducciones_nivel_disponible
+// consulta el procesador en tiempo de ejecución, así el mismo ejecutable usa
+// AVX2 donde existe y SSE2 o la versión escalar en el resto.
+//
+// Las versiones SIMD usan extensiones de GCC/Clang (atributo target y
+// __builtin_cpu_supports) y solo se compilan en x86; en cualquier otro caso
+// todas las llamadas terminan en la versión escalar.
+
+#ifndef REDUCCIONES_SIMD_H
+#define REDUCCIONES_SIMD_H
+
+#include <stdbool.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define REDUCCIONES_CON_SIMD
+#include <immintrin.h>
+#endif
+
+typedef enum {
+    NIVEL_ESCALAR,
+    NIVEL_SSE2,
+    NIVEL_AVX2
+} NivelSimd;
+
+// Retorna el mejor conjunto de instrucciones que soporta el procesador
+static inline NivelSimd reducciones_nivel_disponible(void) {
+#ifdef REDUCCIONES_CON_SIMD
+    if (__builtin_cpu_supports("avx2")) {
+        return NIVEL_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return NIVEL_SSE2;
+    }
+#endif
+    return NIVEL_ESCALAR;
+}
+
+// ---------------------------------------------------------------------------
+// Versiones escalares (referencia y resto final de las versiones SIMD)
+// ---------------------------------------------------------------------------
+
+static inline long long sumar_escalar(const int *datos, int n) {
+    long long suma = 0;
+    for (int i = 0; i < n; i++) {
+        suma += datos[i];
+    }
+    return suma;
+}
+
+static inline void min_max_escalar(const int *datos, int n,
+                                   int *minimo, int *maximo) {
+    for (int i = 0; i < n; i++) {
+        if (datos[i] < *minimo) {
+            *minimo = datos[i];
+        }
+        if (datos[i] > *maximo) {
+            *maximo = datos[i];
+        }
+    }
+}
+
+static inline int contar_escalar(const int *datos, int n, int valor) {
+    int cantidad = 0;
+    for (int i = 0; i < n; i++) {
+        cantidad += datos[i] == valor;
+    }
+    return cantidad;
+}
+
+static inline int buscar_escalar(const int *datos, int n, int valor) {
+    for (int i = 0; i < n; i++) {
+        if (datos[i] == valor) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+#ifdef REDUCCIONES_CON_SIMD
+
+// ---------------------------------------------------------------------------
+// SSE2: 4 int por registro
+// ---------------------------------------------------------------------------
+
+// Suma en acumuladores de 64 bits para no desbordar: cada int se extiende
+// con su signo (SSE2 no tiene una instrucción que lo haga directamente)
+__attribute__((target("sse2")))
+static inline long long sumar_sse2(const int *datos, int n) {
+    __m128i acumulado = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(datos + i));
+        __m128i signo = _mm_srai_epi32(v, 31);
+        acumulado = _mm_add_epi64(acumulado, _mm_unpacklo_epi32(v, signo));
+        acumulado = _mm_add_epi64(acumulado, _mm_unpackhi_epi32(v, signo));
+    }
+    long long partes[2];
+    _mm_storeu_si128((__m128i *)partes, acumulado);
+    return partes[0] + partes[1] + sumar_escalar(datos + i, n - i);
+}
+
+// SSE2 no tiene min/max de enteros de 32 bits: se arman con una
+// comparación y una selección por máscara
+__attribute__((target("sse2")))
+static inline void min_max_sse2(const int *datos, int n,
+                                int *minimo, int *maximo) {
+    __m128i vmin = _mm_set1_epi32(*minimo);
+    __m128i vmax = _mm_set1_epi32(*maximo);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(datos + i));
+        __m128i menor = _mm_cmplt_epi32(v, vmin);
+        vmin = _mm_or_si128(_mm_and_si128(menor, v),
+                            _mm_andnot_si128(menor, vmin));
+        __m128i mayor = _mm_cmpgt_epi32(v, vmax);
+        vmax = _mm_or_si128(_mm_and_si128(mayor, v),
+                            _mm_andnot_si128(mayor, vmax));
+    }
+    int minimos[4];
+    int maximos[4];
+    _mm_storeu_si128((__m128i *)minimos, vmin);
+    _mm_storeu_si128((__m128i *)maximos, vmax);
+    min_max_escalar(minimos, 4, minimo, maximo);
+    min_max_escalar(maximos, 4, minimo, maximo);
+    min_max_escalar(datos + i, n - i, minimo, maximo);
+}
+
+// Cada comparación da -1 en los carriles iguales; restarla suma 1
+__attribute__((target("sse2")))
+static inline int contar_sse2(const int *datos, int n, int valor) {
+    __m128i buscado = _mm_set1_epi32(valor);
+    __m128i cuenta = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(datos + i));
+        cuenta = _mm_sub_epi32(cuenta, _mm_cmpeq_epi32(v, buscado));
+    }
+    int cuentas[4];
+    _mm_storeu_si128((__m128i *)cuentas, cuenta);
+    return cuentas[0] + cuentas[1] + cuentas[2] + cuentas[3] +
+           contar_escalar(datos + i, n - i, valor);
+}
+
+// movemask junta un bit por carril; el primer bit encendido es la posición
+__attribute__((target("sse2")))
+static inline int buscar_sse2(const int *datos, int n, int valor) {
+    __m128i buscado = _mm_set1_epi32(valor);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(datos + i));
+        int mascara = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, buscado)));
+        if (mascara != 0) {
+            return i + __builtin_ctz(mascara);
+        }
+    }
+    int posicion = buscar_escalar(datos + i, n - i, valor);
+    if (posicion < 0) {
+        return -1;
+    }
+    return i + posicion;
+}
+
+// ---------------------------------------------------------------------------
+// AVX2: 8 int por registro
+// ---------------------------------------------------------------------------
+
+__attribute__((target("avx2")))
+static inline long long sumar_avx2(const int *datos, int n) {
+    __m256i acumulado = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i bajo = _mm_loadu_si128((const __m128i *)(datos + i));
+        __m128i alto = _mm_loadu_si128((const __m128i *)(datos + i + 4));
+        acumulado = _mm256_add_epi64(acumulado, _mm256_cvtepi32_epi64(bajo));
+        acumulado = _mm256_add_epi64(acumulado, _mm256_cvtepi32_epi64(alto));
+    }
+    long long partes[4];
+    _mm256_storeu_si256((__m256i *)partes, acumulado);
+    return partes[0] + partes[1] + partes[2] + partes[3] +
+           sumar_escalar(datos + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static inline void min_max_avx2(const int *datos, int n,
+                                int *minimo, int *maximo) {
+    __m256i vmin = _mm256_set1_epi32(*minimo);
+    __m256i vmax = _mm256_set1_epi32(*maximo);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(datos + i));
+        vmin = _mm256_min_epi32(vmin, v);
+        vmax = _mm256_max_epi32(vmax, v);
+    }
+    int minimos[8];
+    int maximos[8];
+    _mm256_storeu_si256((__m256i *)minimos, vmin);
+    _mm256_storeu_si256((__m256i *)maximos, vmax);
+    min_max_escalar(minimos, 8, minimo, maximo);
+    min_max_escalar(maximos, 8, minimo, maximo);
+    min_max_escalar(datos + i, n - i, minimo, maximo);
+}
+
+__attribute__((target("avx2")))
+static inline int contar_avx2(const int *datos, int n, int valor) {
+    __m256i buscado = _mm256_set1_epi32(valor);
+    __m256i cuenta = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(datos + i));
+        cuenta = _mm256_sub_epi32(cuenta, _mm256_cmpeq_epi32(v, buscado));
+    }
+    int cuentas[8];
+    _mm256_storeu_si256((__m256i *)cuentas, cuenta);
+    int total = 0;
+    for (int j = 0; j < 8; j++) {
+        total += cuentas[j];
+    }
+    return total + contar_escalar(datos + i, n - i, valor);
+}
+
+__attribute__((target("avx2")))
+static inline int buscar_avx2(const int *datos, int n, int valor) {
+    __m256i buscado = _mm256_set1_epi32(valor);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i *)(datos + i));
+        __m256i iguales = _mm256_cmpeq_epi32(v, buscado);
+        int mascara = _mm256_movemask_ps(_mm256_castsi256_ps(iguales));
+        if (mascara != 0) {
+            return i + __builtin_ctz(mascara);
+        }
+    }
+    int posicion = buscar_escalar(datos + i, n - i, valor);
+    if (posicion < 0) {
+        return -1;
+    }
+    return i + posicion;
+}
+
+#endif // REDUCCIONES_CON_SIMD
+
+// ---------------------------------------------------------------------------
+// Selección de la versión según el nivel pedido
+// ---------------------------------------------------------------------------
+
+// Suma de los n elementos (en 64 bits para no desbordar)
+static inline long long reducciones_sumar(const int *datos, int n,
+                                          NivelSimd nivel) {
+    switch (nivel) {
+#ifdef REDUCCIONES_CON_SIMD
+        case NIVEL_AVX2:
+            return sumar_avx2(datos, n);
+        case NIVEL_SSE2:
+            return sumar_sse2(datos, n);
+#endif
+        default:
+            return sumar_escalar(datos, n);
+    }
+}
+
+// Actualiza *minimo y *maximo con los n elementos
+// Los valores iniciales deben venir cargados (por ejemplo con datos[0])
+static inline void reducciones_min_max(const int *datos, int n,
+                                       int *minimo, int *maximo,
+                                       NivelSimd nivel) {
+    switch (nivel) {
+#ifdef REDUCCIONES_CON_SIMD
+        case NIVEL_AVX2:
+            min_max_avx2(datos, n, minimo, maximo);
+            break;
+        case NIVEL_SSE2:
+            min_max_sse2(datos, n, minimo, maximo);
+            break;
+#endif
+        default:
+            min_max_escalar(datos, n, minimo, maximo);
+            break;
+    }
+}
+
+// Cantidad de elementos iguales a valor
+static inline int reducciones_contar(const int *datos, int n, int valor,
+                                     NivelSimd nivel) {
+    switch (nivel) {
+#ifdef REDUCCIONES_CON_SIMD
+        case NIVEL_AVX2:
+            return contar_avx2(datos, n, valor);
+        case NIVEL_SSE2:
+            return contar_sse2(datos, n, valor);
+#endif
+        default:
+            return contar_escalar(datos, n, valor);
+    }
+}
+
+// Índice de la primera aparición de valor, o -1 si no está
+static inline int reducciones_buscar(const int *datos, int n, int valor,
+                                     NivelSimd nivel) {
+    switch (nivel) {
+#ifdef REDUCCIONES_CON_SIMD
+        case NIVEL_AVX2:
+            return buscar_avx2(datos, n, valor);
+        case NIVEL_SSE2:
+            return buscar_sse2(datos, n, valor);
+#endif
+        default:
+            return buscar_escalar(datos, n, valor);
+    }
+}
+
+#endif // REDUCCIONES_SIMD_H
@@ -1,20 +1,63 @@
 // TAD Secuencia - Implementación Dinámica
 // Usa memoria dinámica con redimensionamiento automático
 
+// En Linux los buffers grandes se pasan a una región de mmap que crece
+// con mremap (extensión GNU), moviendo páginas en lugar de copiar datos
+#ifdef __linux__
+#define _GNU_SOURCE
+#define SECUENCIA_CON_MMAP
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef SECUENCIA_CON_MMAP
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "reducciones_simd.h"
+#include "escritor.h"
 
 #define CAPACIDAD_INICIAL 4
+// Solo se achica si se usa menos de 1/FACTOR_HISTERESIS de la capacidad,
+// así alternar agregados y ajustes no provoca realloc en cada llamada
+#define FACTOR_HISTERESIS 4
+// Elementos que suma cada crecimiento con CRECIMIENTO_BLOQUE (4 MiB de int)
+#define BLOQUE_CRECIMIENTO (1 << 20)
+// A partir de este tamaño el buffer pasa a mmap (si se pidió al crear)
+#define UMBRAL_MMAP_BYTES ((size_t)64 << 20)
+
+// Cómo se calcula la nueva capacidad cuando la secuencia se llena
+typedef enum {
+    CRECIMIENTO_DOBLE,   // x2: pocas copias, hasta 50% de memoria ociosa
+    CRECIMIENTO_MEDIO,   // x1.5: más copias, hasta 33% de memoria ociosa
+    CRECIMIENTO_BLOQUE   // +BLOQUE_CRECIMIENTO: poca memoria ociosa, O(n^2) copias
+} PoliticaCrecimiento;
 
 typedef struct {
     int *elementos;
     int longitud;
     int capacidad;
+    PoliticaCrecimiento politica;
+    bool usar_mmap;          // Permite pasar a mmap al superar el umbral
+    bool mapeada;            // elementos vive en una región de mmap
+    size_t bytes_mapeados;   // Tamaño de la región (múltiplo de página)
+    size_t bytes_copiados;   // Bytes movidos al cambiar de buffer
 } Secuencia;
 
-// Crea una secuencia vacía
-Secuencia *secuencia_crear(void) {
+// Crea una secuencia vacía con la política de crecimiento indicada
+// Si usar_mmap es true, al superar UMBRAL_MMAP_BYTES el buffer se mueve a
+// una región de mmap (solo en Linux; en otros sistemas se ignora)
+Secuencia *secuencia_crear_con_politica(PoliticaCrecimiento politica,
+                                        bool usar_mmap) {
     Secuencia *sec = malloc(sizeof(Secuencia));
     if (sec == NULL) {
         return NULL;
@@ -28,31 +71,142 @@ Secuencia *secuencia_crear(void) {
     
     sec->longitud = 0;
     sec->capacidad = CAPACIDAD_INICIAL;
+    sec->politica = politica;
+    sec->usar_mmap = usar_mmap;
+    sec->mapeada = false;
+    sec->bytes_mapeados = 0;
+    sec->bytes_copiados = 0;
     return sec;
 }
 
+// Crea una secuencia vacía
+Secuencia *secuencia_crear(void) {
+    return secuencia_crear_con_politica(CRECIMIENTO_DOBLE, false);
+}
+
 // Destruye la secuencia
 void secuencia_destruir(Secuencia *sec) {
     if (sec != NULL) {
+#ifdef SECUENCIA_CON_MMAP
+        if (sec->mapeada) {
+            munmap(sec->elementos, sec->bytes_mapeados);
+        } else {
+            free(sec->elementos);
+        }
+#else
         free(sec->elementos);
+#endif
         free(sec);
     }
 }
 
-// Redimensiona la capacidad interna
-static bool secuencia_redimensionar(Secuencia *sec) {
-    int nueva_capacidad = sec->capacidad * 2;
+#ifdef SECUENCIA_CON_MMAP
+// Lleva el buffer a una región de mmap de al menos bytes bytes
+// La primera vez copia los datos desde el heap; después mremap solo
+// reubica páginas, sin copiar el contenido
+static bool secuencia_cambiar_capacidad_mapeada(Secuencia *sec, size_t bytes) {
+    size_t pagina = (size_t)sysconf(_SC_PAGESIZE);
+    bytes = (bytes + pagina - 1) / pagina * pagina;
+    
+    void *region;
+    if (sec->mapeada) {
+        region = mremap(sec->elementos, sec->bytes_mapeados, bytes,
+                        MREMAP_MAYMOVE);
+    } else {
+        region = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+    if (region == MAP_FAILED) {
+        return false;
+    }
+    
+    if (!sec->mapeada) {
+        memcpy(region, sec->elementos, sec->longitud * sizeof(int));
+        sec->bytes_copiados += sec->longitud * sizeof(int);
+        free(sec->elementos);
+        sec->mapeada = true;
+    }
+    
+    sec->elementos = region;
+    sec->bytes_mapeados = bytes;
+    // El redondeo a página se aprovecha como capacidad extra
+    size_t capacidad = bytes / sizeof(int);
+    if (capacidad > INT_MAX) {
+        capacidad = INT_MAX;
+    }
+    sec->capacidad = (int)capacidad;
+    return true;
+}
+#endif
+
+// Cambia la capacidad interna a (al menos) nueva_capacidad elementos
+static bool secuencia_cambiar_capacidad(Secuencia *sec, int nueva_capacidad) {
+#ifdef SECUENCIA_CON_MMAP
+    size_t bytes = (size_t)nueva_capacidad * sizeof(int);
+    if (sec->mapeada || (sec->usar_mmap && bytes >= UMBRAL_MMAP_BYTES)) {
+        return secuencia_cambiar_capacidad_mapeada(sec, bytes);
+    }
+#endif
+    
+    // Se guarda la dirección como número: comparar un puntero ya liberado
+    // por realloc no está definido
+    uintptr_t anterior = (uintptr_t)sec->elementos;
     int *nuevos_elementos = realloc(sec->elementos, nueva_capacidad * sizeof(int));
     
     if (nuevos_elementos == NULL) {
         return false;
     }
     
+    // Si el bloque cambió de lugar, realloc tuvo que mover los datos
+    if ((uintptr_t)nuevos_elementos != anterior) {
+        sec->bytes_copiados += sec->longitud * sizeof(int);
+    }
+    
     sec->elementos = nuevos_elementos;
     sec->capacidad = nueva_capacidad;
     return true;
 }
 
+// Calcula la capacidad siguiente según la política de la secuencia
+// Retorna -1 si superaría INT_MAX
+static int secuencia_capacidad_siguiente(const Secuencia *sec) {
+    long long nueva_capacidad;
+    switch (sec->politica) {
+        case CRECIMIENTO_MEDIO:
+            nueva_capacidad = sec->capacidad + sec->capacidad / 2LL;
+            break;
+        case CRECIMIENTO_BLOQUE:
+            nueva_capacidad = sec->capacidad + (long long)BLOQUE_CRECIMIENTO;
+            break;
+        case CRECIMIENTO_DOBLE:
+        default:
+            nueva_capacidad = sec->capacidad * 2LL;
+            break;
+    }
+    if (nueva_capacidad > INT_MAX) {
+        return -1;
+    }
+    return (int)nueva_capacidad;
+}
+
+// Redimensiona la capacidad interna
+static bool secuencia_redimensionar(Secuencia *sec) {
+    int nueva_capacidad = secuencia_capacidad_siguiente(sec);
+    if (nueva_capacidad < 0) {
+        return false;
+    }
+    return secuencia_cambiar_capacidad(sec, nueva_capacidad);
+}
+
+// Garantiza lugar para al menos capacidad_minima elementos
+// No achica la secuencia si ya tiene más capacidad
+bool secuencia_reservar(Secuencia *sec, int capacidad_minima) {
+    if (capacidad_minima <= sec->capacidad) {
+        return true;
+    }
+    return secuencia_cambiar_capacidad(sec, capacidad_minima);
+}
+
 // Agrega un elemento al final
 bool secuencia_agregar(Secuencia *sec, int valor) {
     if (sec->longitud >= sec->capacidad) {
@@ -66,6 +220,47 @@ bool secuencia_agregar(Secuencia *sec, int valor) {
     return true;
 }
 
+// Agrega cantidad elementos al final con un único crecimiento y una copia
+bool secuencia_agregar_lote(Secuencia *sec, const int *valores, int cantidad) {
+    if (cantidad < 0 || cantidad > INT_MAX - sec->longitud) {
+        return false;
+    }
+    
+    int necesaria = sec->longitud + cantidad;
+    if (necesaria > sec->capacidad) {
+        // Se mantiene el crecimiento geométrico para que lotes chicos
+        // seguidos no redimensionen en cada llamada
+        int nueva_capacidad = secuencia_capacidad_siguiente(sec);
+        if (nueva_capacidad < necesaria) {
+            nueva_capacidad = necesaria;
+        }
+        if (!secuencia_cambiar_capacidad(sec, nueva_capacidad)) {
+            return false;
+        }
+    }
+    
+    memcpy(sec->elementos + sec->longitud, valores, cantidad * sizeof(int));
+    sec->longitud = necesaria;
+    return true;
+}
+
+// Libera la capacidad sobrante (shrink to fit)
+// Solo actúa si la ocupación cayó por debajo de 1/FACTOR_HISTERESIS
+bool secuencia_ajustar(Secuencia *sec) {
+    if (sec->longitud >= sec->capacidad / FACTOR_HISTERESIS) {
+        return true;
+    }
+    
+    int nueva_capacidad = sec->longitud;
+    if (nueva_capacidad < CAPACIDAD_INICIAL) {
+        nueva_capacidad = CAPACIDAD_INICIAL;
+    }
+    if (nueva_capacidad == sec->capacidad) {
+        return true;
+    }
+    return secuencia_cambiar_capacidad(sec, nueva_capacidad);
+}
+
 // Obtiene un elemento por índice
 bool secuencia_obtener(const Secuencia *sec, int indice, int *valor) {
     if (indice < 0 || indice >= sec->longitud) {
@@ -75,19 +270,342 @@ bool secuencia_obtener(const Secuencia *sec, int indice, int *valor) {
     return true;
 }
 
+// Suma de todos los elementos (en 64 bits para no desbordar)
+// Las reducciones recorren elementos directamente con la mejor versión
+// SIMD disponible, sin pasar por secuencia_obtener en cada elemento
+long long secuencia_sumar(const Secuencia *sec) {
+    return reducciones_sumar(sec->elementos, sec->longitud,
+                             reducciones_nivel_disponible());
+}
+
+// Obtiene el mínimo y el máximo; retorna false si la secuencia está vacía
+bool secuencia_min_max(const Secuencia *sec, int *minimo, int *maximo) {
+    if (sec->longitud == 0) {
+        return false;
+    }
+    *minimo = sec->elementos[0];
+    *maximo = sec->elementos[0];
+    reducciones_min_max(sec->elementos, sec->longitud, minimo, maximo,
+                        reducciones_nivel_disponible());
+    return true;
+}
+
+// Cuenta los elementos iguales a valor
+int secuencia_contar(const Secuencia *sec, int valor) {
+    return reducciones_contar(sec->elementos, sec->longitud, valor,
+                              reducciones_nivel_disponible());
+}
+
+// Retorna el índice de la primera aparición de valor, o -1 si no está
+int secuencia_buscar(const Secuencia *sec, int valor) {
+    return reducciones_buscar(sec->elementos, sec->longitud, valor,
+                              reducciones_nivel_disponible());
+}
+
+// Escribe la secuencia en destino
+void secuencia_escribir(const Secuencia *sec, FILE *destino) {
+    Escritor escritor;
+    escritor_iniciar(&escritor, destino);
+    escritor_cadena(&escritor, "[");
+    for (int i = 0; i < sec->longitud; i++) {
+        escritor_entero(&escritor, sec->elementos[i]);
+        if (i < sec->longitud - 1) {
+            escritor_cadena(&escritor, ", ");
+        }
+    }
+    escritor_cadena(&escritor, "] (capacidad: ");
+    escritor_entero(&escritor, sec->capacidad);
+    escritor_cadena(&escritor, ")\n");
+    escritor_vaciar(&escritor);
+}
+
 // Imprime la secuencia
 void secuencia_imprimir(const Secuencia *sec) {
-    printf("[");
+    secuencia_escribir(sec, stdout);
+}
+
+// Mide la carga de n elementos de a uno y en lote, en millones por segundo
+static void benchmark_ingesta_tamano(const int *origen, int n) {
+    // Los tamaños chicos se repiten para que el tiempo sea medible
+    int repeticiones = 100000000 / n;
+    if (repeticiones < 1) {
+        repeticiones = 1;
+    }
+    
+    clock_t inicio = clock();
+    for (int r = 0; r < repeticiones; r++) {
+        Secuencia *sec = secuencia_crear();
+        for (int i = 0; i < n; i++) {
+            secuencia_agregar(sec, origen[i]);
+        }
+        secuencia_destruir(sec);
+    }
+    double t_individual = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    
+    inicio = clock();
+    for (int r = 0; r < repeticiones; r++) {
+        Secuencia *sec = secuencia_crear();
+        secuencia_agregar_lote(sec, origen, n);
+        secuencia_destruir(sec);
+    }
+    double t_lote = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    
+    double total = (double)n * repeticiones / 1e6;
+    printf("%12d %16.1f %16.1f %10.1fx\n", n,
+           total / t_individual, total / t_lote, t_individual / t_lote);
+}
+
+// Compara secuencia_agregar contra secuencia_agregar_lote de 10^3 a 10^max
+static int benchmark_ingesta(int exponente_maximo) {
+    int n_maximo = 1;
+    for (int e = 0; e < exponente_maximo; e++) {
+        n_maximo *= 10;
+    }
+    
+    int *origen = malloc(n_maximo * sizeof(int));
+    if (origen == NULL) {
+        fprintf(stderr, "No hay memoria para %d elementos\n", n_maximo);
+        return 1;
+    }
+    for (int i = 0; i < n_maximo; i++) {
+        origen[i] = i;
+    }
+    
+    printf("%12s %16s %16s %11s\n", "elementos", "de a uno (M/s)",
+           "en lote (M/s)", "mejora");
+    // Se avanza por exponente: con 10^9, un n *= 10 de más desbordaría int
+    int n = 1000;
+    for (int e = 3; e <= exponente_maximo; e++) {
+        benchmark_ingesta_tamano(origen, n);
+        if (e < exponente_maximo) {
+            n *= 10;
+        }
+    }
+    
+    free(origen);
+    return 0;
+}
+
+#ifdef SECUENCIA_CON_MMAP
+// Carga n elementos de a uno con una política y reporta tiempo, bytes
+// copiados y pico de memoria residente
+// Corre en un proceso hijo para que el pico de RSS sea solo de esta carga
+static void benchmark_crecimiento_politica(const char *nombre,
+                                           PoliticaCrecimiento politica,
+                                           bool usar_mmap, int n) {
+    fflush(stdout);
+    pid_t hijo = fork();
+    if (hijo < 0) {
+        perror("fork");
+        return;
+    }
+    if (hijo > 0) {
+        waitpid(hijo, NULL, 0);
+        return;
+    }
+    
+    Secuencia *sec = secuencia_crear_con_politica(politica, usar_mmap);
+    if (sec == NULL) {
+        _exit(1);
+    }
+    clock_t inicio = clock();
+    bool ok = true;
+    for (int i = 0; i < n && ok; i++) {
+        ok = secuencia_agregar(sec, i);
+    }
+    double segundos = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    
+    struct rusage uso;
+    getrusage(RUSAGE_SELF, &uso);
+    printf("%-8s %-7s %9.3f %14.1f %14.1f %12.1f%s\n", nombre,
+           usar_mmap ? "mremap" : "realloc", segundos,
+           sec->bytes_copiados / 1048576.0,
+           uso.ru_maxrss / 1024.0,
+           (double)sec->capacidad * sizeof(int) / 1048576.0,
+           ok ? "" : " (sin memoria)");
+    fflush(stdout);
+    secuencia_destruir(sec);
+    _exit(0);
+}
+
+// Compara las políticas de crecimiento al cargar 10^exponente elementos
+// "movido" cuenta los bytes de cada cambio de dirección del buffer; para
+// bloques grandes glibc también puede resolver realloc con mremap, así que
+// en la columna realloc es una cota superior de lo realmente copiado
+static int benchmark_crecimiento(int exponente) {
+    int n = 1;
+    for (int e = 0; e < exponente; e++) {
+        n *= 10;
+    }
+    
+    printf("Carga de %d elementos (%.1f MiB de datos)\n", n,
+           (double)n * sizeof(int) / 1048576.0);
+    printf("%-8s %-7s %9s %14s %14s %12s\n", "politica", "buffer",
+           "segundos", "movido (MiB)", "pico RSS (MiB)", "capac. (MiB)");
+    
+    const char *nombres[] = {"x2", "x1.5", "bloque"};
+    PoliticaCrecimiento politicas[] = {
+        CRECIMIENTO_DOBLE, CRECIMIENTO_MEDIO, CRECIMIENTO_BLOQUE
+    };
+    for (int i = 0; i < 3; i++) {
+        benchmark_crecimiento_politica(nombres[i], politicas[i], false, n);
+        benchmark_crecimiento_politica(nombres[i], politicas[i], true, n);
+    }
+    return 0;
+}
+#endif
+
+// Corre cada reducción repeticiones veces con un nivel SIMD e imprime GB/s
+// Todos los resultados se acumulan en un volatile para que el compilador
+// no descarte las llamadas
+static void benchmark_reducciones_nivel(const char *nombre, NivelSimd nivel,
+                                        const int *datos, int n,
+                                        int repeticiones) {
+    volatile long long sumidero = 0;
+    double gigabytes = (double)n * sizeof(int) * repeticiones / 1e9;
+    double tiempos[4];
+    
+    clock_t inicio = clock();
+    for (int r = 0; r < repeticiones; r++) {
+        sumidero += reducciones_sumar(datos, n, nivel);
+    }
+    tiempos[0] = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    
+    inicio = clock();
+    for (int r = 0; r < repeticiones; r++) {
+        int minimo = datos[0];
+        int maximo = datos[0];
+        reducciones_min_max(datos, n, &minimo, &maximo, nivel);
+        sumidero += minimo + maximo;
+    }
+    tiempos[1] = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    
+    inicio = clock();
+    for (int r = 0; r < repeticiones; r++) {
+        sumidero += reducciones_contar(datos, n, 7, nivel);
+    }
+    tiempos[2] = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    
+    // Se busca un valor ausente para recorrer el arreglo completo
+    inicio = clock();
+    for (int r = 0; r < repeticiones; r++) {
+        sumidero += reducciones_buscar(datos, n, INT_MAX, nivel);
+    }
+    tiempos[3] = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    
+    printf("%-8s", nombre);
+    for (int k = 0; k < 4; k++) {
+        printf(" %10.2f", gigabytes / tiempos[k]);
+    }
+    printf("\n");
+}
+
+// Verifica que todas las versiones den lo mismo que la escalar
+static bool reducciones_coinciden(const int *datos, int n, NivelSimd nivel) {
+    int min_a = datos[0];
+    int max_a = datos[0];
+    int min_b = datos[0];
+    int max_b = datos[0];
+    reducciones_min_max(datos, n, &min_a, &max_a, NIVEL_ESCALAR);
+    reducciones_min_max(datos, n, &min_b, &max_b, nivel);
+    int objetivo = datos[n - 1];
+    return reducciones_sumar(datos, n, NIVEL_ESCALAR) ==
+               reducciones_sumar(datos, n, nivel) &&
+           min_a == min_b && max_a == max_b &&
+           reducciones_contar(datos, n, 7, NIVEL_ESCALAR) ==
+               reducciones_contar(datos, n, 7, nivel) &&
+           reducciones_buscar(datos, n, objetivo, NIVEL_ESCALAR) ==
+               reducciones_buscar(datos, n, objetivo, nivel);
+}
+
+// Mide el ancho de banda de cada reducción con n elementos (cerca de 1 GB
+// leído por medición)
+static int benchmark_reducciones(int n) {
+    int *datos = malloc(n * sizeof(int));
+    if (datos == NULL) {
+        fprintf(stderr, "No hay memoria para %d elementos\n", n);
+        return 1;
+    }
+    for (int i = 0; i < n; i++) {
+        datos[i] = (int)(((long long)i * 7919) % 20011) - 10000;
+    }
+    int repeticiones = (int)(1e9 / ((double)n * sizeof(int)));
+    if (repeticiones < 1) {
+        repeticiones = 1;
+    }
+    
+    const char *nombres[] = {"escalar", "sse2", "avx2"};
+    NivelSimd disponible = reducciones_nivel_disponible();
+    printf("%d elementos (%.1f KiB), GB/s\n", n, n * sizeof(int) / 1024.0);
+    printf("%-8s %10s %10s %10s %10s\n", "nivel", "sumar", "min_max",
+           "contar", "buscar");
+    for (int nivel = NIVEL_ESCALAR; nivel <= (int)disponible; nivel++) {
+        if (!reducciones_coinciden(datos, n, (NivelSimd)nivel)) {
+            printf("%-8s resultados distintos a la versión escalar\n",
+                   nombres[nivel]);
+        }
+        benchmark_reducciones_nivel(nombres[nivel], (NivelSimd)nivel, datos, n,
+                                    repeticiones);
+    }
+    
+    free(datos);
+    return 0;
+}
+
+// Versión anterior de secuencia_escribir, con un printf por elemento
+static void secuencia_escribir_printf(const Secuencia *sec, FILE *destino) {
+    fprintf(destino, "[");
     for (int i = 0; i < sec->longitud; i++) {
-        printf("%d", sec->elementos[i]);
+        fprintf(destino, "%d", sec->elementos[i]);
         if (i < sec->longitud - 1) {
-            printf(", ");
+            fprintf(destino, ", ");
         }
     }
-    printf("] (capacidad: %d)\n", sec->capacidad);
+    fprintf(destino, "] (capacidad: %d)\n", sec->capacidad);
+}
+
+// Escribe la secuencia en un archivo temporal y retorna los MB/s logrados
+static double medir_escritura(const Secuencia *sec,
+                              void (*escribir)(const Secuencia *, FILE *)) {
+    FILE *archivo = tmpfile();
+    if (archivo == NULL) {
+        perror("tmpfile");
+        return 0.0;
+    }
+    clock_t inicio = clock();
+    escribir(sec, archivo);
+    fflush(archivo);
+    double segundos = (double)(clock() - inicio) / CLOCKS_PER_SEC;
+    double megabytes = ftell(archivo) / 1e6;
+    fclose(archivo);
+    return megabytes / segundos;
 }
 
-int main(void) {
+// Compara la escritura con printf contra el Escritor con n elementos
+static int benchmark_impresion(int n) {
+    Secuencia *sec = secuencia_crear();
+    if (sec == NULL || !secuencia_reservar(sec, n)) {
+        fprintf(stderr, "No hay memoria para %d elementos\n", n);
+        secuencia_destruir(sec);
+        return 1;
+    }
+    for (int i = 0; i < n; i++) {
+        int valor = (int)(((long long)i * 7919) % 2000003) - 1000000;
+        secuencia_agregar(sec, valor);
+    }
+    
+    double con_printf = medir_escritura(sec, secuencia_escribir_printf);
+    double con_escritor = medir_escritura(sec, secuencia_escribir);
+    printf("Escritura de %d elementos\n", n);
+    printf("%-10s %10s\n", "versión", "MB/s");
+    printf("%-10s %10.1f\n", "printf", con_printf);
+    printf("%-10s %10.1f\n", "escritor", con_escritor);
+    
+    secuencia_destruir(sec);
+    return 0;
+}
+
+static int demostracion(void) {
     Secuencia *mi_secuencia = secuencia_crear();
     if (mi_secuencia == NULL) {
         fprintf(stderr, "Error al crear la secuencia\n");
@@ -101,6 +619,91 @@ int main(void) {
         secuencia_imprimir(mi_secuencia);
     }
     
+    printf("\nAgregando un lote de 20 elementos...\n");
+    int lote[20];
+    for (int i = 0; i < 20; i++) {
+        lote[i] = 110 + i * 10;
+    }
+    secuencia_agregar_lote(mi_secuencia, lote, 20);
+    secuencia_imprimir(mi_secuencia);
+    
+    printf("\nReservando lugar para 1000 elementos...\n");
+    secuencia_reservar(mi_secuencia, 1000);
+    secuencia_imprimir(mi_secuencia);
+    
+    printf("\nAjustando la capacidad a la longitud...\n");
+    secuencia_ajustar(mi_secuencia);
+    secuencia_imprimir(mi_secuencia);
+    
+    int minimo;
+    int maximo;
+    secuencia_min_max(mi_secuencia, &minimo, &maximo);
+    printf("\nSuma: %lld, mínimo: %d, máximo: %d\n",
+           secuencia_sumar(mi_secuencia), minimo, maximo);
+    printf("Posición del 150: %d, apariciones del 150: %d\n",
+           secuencia_buscar(mi_secuencia, 150),
+           secuencia_contar(mi_secuencia, 150));
+    
     secuencia_destruir(mi_secuencia);
     return 0;
 }
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        return demostracion();
+    }
+    
+    if (strcmp(argv[1], "ingesta") == 0) {
+        int exponente_maximo = 8;
+        if (argc == 3) {
+            exponente_maximo = atoi(argv[2]);
+        }
+        if (exponente_maximo < 3 || exponente_maximo > 9) {
+            fprintf(stderr, "El exponente debe estar entre 3 y 9\n");
+            return 1;
+        }
+        return benchmark_ingesta(exponente_maximo);
+    }
+    
+    if (strcmp(argv[1], "reducciones") == 0) {
+        int n = 10000000;
+        if (argc == 3) {
+            n = atoi(argv[2]);
+        }
+        if (n <= 0) {
+            fprintf(stderr, "La cantidad de elementos debe ser positiva\n");
+            return 1;
+        }
+        return benchmark_reducciones(n);
+    }
+    
+    if (strcmp(argv[1], "impresion") == 0) {
+        int n = 10000000;
+        if (argc == 3) {
+            n = atoi(argv[2]);
+        }
+        if (n <= 0) {
+            fprintf(stderr, "La cantidad de elementos debe ser positiva\n");
+            return 1;
+        }
+        return benchmark_impresion(n);
+    }
+    
+#ifdef SECUENCIA_CON_MMAP
+    if (strcmp(argv[1], "crecimiento") == 0) {
+        int exponente = 8;
+        if (argc == 3) {
+            exponente = atoi(argv[2]);
+        }
+        if (exponente < 3 || exponente > 9) {
+            fprintf(stderr, "El exponente debe estar entre 3 y 9\n");
+            return 1;
+        }
+        return benchmark_crecimiento(exponente);
+    }
+#endif
+    
+    printf("Uso: %s [ingesta [exponente_maximo] | crecimiento [exponente] |\n"
+           "        reducciones [elementos] | impresion [elementos]]\n", argv[0]);
+    return 1;
+}
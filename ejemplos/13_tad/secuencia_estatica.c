@@ -4,6 +4,8 @@
 #include <stdio.h>
 #include <stdbool.h>
 
+#include "escritor.h"
+
 #define MAX_CAPACIDAD 100
 
 typedef struct {
@@ -56,14 +58,17 @@ bool secuencia_modificar(Secuencia *sec, int indice, int valor) {
 
 // Imprime la secuencia
 void secuencia_imprimir(const Secuencia *sec) {
-    printf("[");
+    Escritor escritor;
+    escritor_iniciar(&escritor, stdout);
+    escritor_cadena(&escritor, "[");
     for (int i = 0; i < sec->longitud; i++) {
-        printf("%d", sec->elementos[i]);
+        escritor_entero(&escritor, sec->elementos[i]);
         if (i < sec->longitud - 1) {
-            printf(", ");
+            escritor_cadena(&escritor, ", ");
         }
     }
-    printf("]\n");
+    escritor_cadena(&escritor, "]\n");
+    escritor_vaciar(&escritor);
 }
 
 int main(void) {
@@ -0,0 +1,227 @@
+// TAD Secuencia estática genérica - Capacidad y tipo elegidos al compilar
+// Usa secuencia_estatica_generica.h y compara sus accesos con y sin
+// verificación contra la Secuencia de secuencia_estatica.c
+//
+// Para ver qué lazos vectorizó el compilador:
+//     gcc -O3 -fopt-info-vec-optimized secuencia_estatica_generica.c
+// o buscar instrucciones SIMD (paddd, addps, vmovdqu, ...) en el
+// ensamblador generado con:
+//     gcc -O3 -S secuencia_estatica_generica.c
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "secuencia_estatica_generica.h"
+
+#define MAX_CAPACIDAD 100
+
+SECUENCIA_ESTATICA_DEFINIR(int, MAX_CAPACIDAD, secuencia_int)
+SECUENCIA_ESTATICA_DEFINIR(int, 4096, secuencia_int_grande)
+SECUENCIA_ESTATICA_DEFINIR(float, 8, secuencia_float)
+
+// Referencia para el benchmark: la Secuencia de secuencia_estatica.c, con
+// MAX_CAPACIDAD fija y verificación en cada acceso
+typedef struct {
+    int elementos[MAX_CAPACIDAD];
+    int longitud;
+} Secuencia;
+
+static void secuencia_crear(Secuencia *sec) {
+    sec->longitud = 0;
+}
+
+static bool secuencia_agregar(Secuencia *sec, int valor) {
+    if (sec->longitud >= MAX_CAPACIDAD) {
+        return false;
+    }
+    sec->elementos[sec->longitud] = valor;
+    sec->longitud++;
+    return true;
+}
+
+static bool secuencia_obtener(const Secuencia *sec, int indice, int *valor) {
+    if (indice < 0 || indice >= sec->longitud) {
+        return false;
+    }
+    *valor = sec->elementos[indice];
+    return true;
+}
+
+// secuencia_estatica.c vive en otra unidad de compilación: el compilador
+// no puede integrar sus funciones ni sacar las verificaciones de adentro
+// de los lazos. Llamarlas a través de punteros volatile reproduce esa
+// situación aunque estén en este mismo archivo.
+typedef bool (*FuncionAgregar)(Secuencia *, int);
+typedef bool (*FuncionObtener)(const Secuencia *, int, int *);
+
+static double segundos_desde(clock_t inicio) {
+    return (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// Cada medición llena una secuencia de MAX_CAPACIDAD elementos y la
+// recorre sumando, repeticiones veces. Retorna nanosegundos por elemento
+// (agregar + obtener).
+
+static double medir_original(int repeticiones, long long *suma) {
+    FuncionAgregar volatile agregar = secuencia_agregar;
+    FuncionObtener volatile obtener = secuencia_obtener;
+    Secuencia sec;
+    clock_t inicio = clock();
+    for (int r = 0; r < repeticiones; r++) {
+        secuencia_crear(&sec);
+        for (int i = 0; i < MAX_CAPACIDAD; i++) {
+            agregar(&sec, i + r);
+        }
+        for (int i = 0; i < sec.longitud; i++) {
+            int valor = 0;
+            if (obtener(&sec, i, &valor)) {
+                *suma += valor;
+            }
+        }
+    }
+    return segundos_desde(inicio) * 1e9 / ((double)repeticiones * MAX_CAPACIDAD);
+}
+
+static double medir_verificando(int repeticiones, long long *suma) {
+    secuencia_int sec;
+    clock_t inicio = clock();
+    for (int r = 0; r < repeticiones; r++) {
+        secuencia_int_crear(&sec);
+        for (int i = 0; i < secuencia_int_capacidad(); i++) {
+            secuencia_int_agregar(&sec, i + r);
+        }
+        for (int i = 0; i < secuencia_int_longitud(&sec); i++) {
+            int valor = 0;
+            if (secuencia_int_obtener(&sec, i, &valor)) {
+                *suma += valor;
+            }
+        }
+    }
+    return segundos_desde(inicio) * 1e9 / ((double)repeticiones * MAX_CAPACIDAD);
+}
+
+static double medir_sin_verificar(int repeticiones, long long *suma) {
+    secuencia_int sec;
+    clock_t inicio = clock();
+    for (int r = 0; r < repeticiones; r++) {
+        secuencia_int_crear(&sec);
+        for (int i = 0; i < secuencia_int_capacidad(); i++) {
+            secuencia_int_agregar_sin_verificar(&sec, i + r);
+        }
+        int longitud = secuencia_int_longitud(&sec);
+        for (int i = 0; i < longitud; i++) {
+            *suma += secuencia_int_obtener_sin_verificar(&sec, i);
+        }
+    }
+    return segundos_desde(inicio) * 1e9 / ((double)repeticiones * MAX_CAPACIDAD);
+}
+
+// Igual que medir_sin_verificar pero agregando por lotes desde un arreglo
+static double medir_lote(int repeticiones, long long *suma) {
+    secuencia_int sec;
+    int valores[MAX_CAPACIDAD];
+    clock_t inicio = clock();
+    for (int r = 0; r < repeticiones; r++) {
+        for (int i = 0; i < MAX_CAPACIDAD; i++) {
+            valores[i] = i + r;
+        }
+        secuencia_int_crear(&sec);
+        secuencia_int_agregar_lote(&sec, valores, MAX_CAPACIDAD);
+        int longitud = secuencia_int_longitud(&sec);
+        for (int i = 0; i < longitud; i++) {
+            *suma += secuencia_int_obtener_sin_verificar(&sec, i);
+        }
+    }
+    return segundos_desde(inicio) * 1e9 / ((double)repeticiones * MAX_CAPACIDAD);
+}
+
+// Con una capacidad más grande, fija al compilar, el recorrido sin
+// verificar no queda limitado por el costo de arrancar cada lazo
+static double medir_grande(int repeticiones, long long *suma) {
+    static secuencia_int_grande sec;
+    int capacidad = secuencia_int_grande_capacidad();
+    clock_t inicio = clock();
+    for (int r = 0; r < repeticiones; r++) {
+        secuencia_int_grande_crear(&sec);
+        for (int i = 0; i < capacidad; i++) {
+            secuencia_int_grande_agregar_sin_verificar(&sec, i + r);
+        }
+        int longitud = secuencia_int_grande_longitud(&sec);
+        for (int i = 0; i < longitud; i++) {
+            *suma += secuencia_int_grande_obtener_sin_verificar(&sec, i);
+        }
+    }
+    return segundos_desde(inicio) * 1e9 / ((double)repeticiones * capacidad);
+}
+
+static int benchmark(int repeticiones) {
+    long long sumas[4] = {0, 0, 0, 0};
+    printf("Secuencias de %d int, %d repeticiones (ns por elemento)\n",
+           MAX_CAPACIDAD, repeticiones);
+    printf("%-26s %8.3f\n", "secuencia_estatica.c",
+           medir_original(repeticiones, &sumas[0]));
+    printf("%-26s %8.3f\n", "generada, verificando",
+           medir_verificando(repeticiones, &sumas[1]));
+    printf("%-26s %8.3f\n", "generada, sin verificar",
+           medir_sin_verificar(repeticiones, &sumas[2]));
+    printf("%-26s %8.3f\n", "generada, lote",
+           medir_lote(repeticiones, &sumas[3]));
+    
+    long long suma_grande = 0;
+    int repeticiones_grande = repeticiones / 40;
+    if (repeticiones_grande < 1) {
+        repeticiones_grande = 1;
+    }
+    printf("%-26s %8.3f\n", "capacidad 4096, sin verif.",
+           medir_grande(repeticiones_grande, &suma_grande));
+    
+    bool coinciden = sumas[0] == sumas[1] && sumas[1] == sumas[2] &&
+                     sumas[2] == sumas[3];
+    printf("Sumas %s\n", coinciden ? "iguales" : "DISTINTAS");
+    return coinciden ? 0 : 1;
+}
+
+static int demostracion(void) {
+    secuencia_float sec;
+    secuencia_float_crear(&sec);
+    printf("Capacidad fija al compilar: %d\n", secuencia_float_capacidad());
+    
+    float lote[] = {1.5f, 2.5f, 3.5f};
+    secuencia_float_agregar_lote(&sec, lote, 3);
+    secuencia_float_agregar(&sec, 4.5f);
+    printf("Longitud: %d\n", secuencia_float_longitud(&sec));
+    
+    float valor;
+    if (!secuencia_float_obtener(&sec, 10, &valor)) {
+        printf("Índice 10 fuera de rango (acceso verificado)\n");
+    }
+    secuencia_float_modificar_sin_verificar(&sec, 0, 0.5f);
+    
+    float suma = 0.0f;
+    for (int i = 0; i < secuencia_float_longitud(&sec); i++) {
+        suma += secuencia_float_obtener_sin_verificar(&sec, i);
+    }
+    printf("Suma: %.1f\n", suma);
+    
+    float muchos[8] = {0};
+    if (!secuencia_float_agregar_lote(&sec, muchos, 8)) {
+        printf("Un lote de 8 no entra: no se agrega ninguno (longitud %d)\n",
+               secuencia_float_longitud(&sec));
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        return demostracion();
+    }
+    
+    if (strcmp(argv[1], "benchmark") == 0) {
+        return benchmark(2000000);
+    }
+    
+    printf("Uso: %s [benchmark]\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,127 @@
+// TAD Secuencia estática genérica generada con macros
+//
+// SECUENCIA_ESTATICA_DEFINIR(tipo, capacidad, nombre) genera el tipo
+// `nombre`, con lugar para `capacidad` elementos de `tipo` dentro del
+// propio struct, y sus funciones. A diferencia de secuencia_estatica.c,
+// donde MAX_CAPACIDAD vale 100 para todas las secuencias, cada tipo
+// generado tiene su capacidad, conocida al compilar.
+//
+// Los accesos vienen en dos versiones:
+// - nombre_agregar, nombre_obtener, nombre_modificar verifican la
+//   capacidad o el índice y retornan false si no son válidos.
+// - nombre_agregar_sin_verificar, nombre_obtener_sin_verificar y
+//   nombre_modificar_sin_verificar no verifican nada: quien llama garantiza
+//   que hay lugar o que el índice está entre 0 y la longitud. Sin la rama
+//   de error, un for que los usa queda como un recorrido simple de un
+//   arreglo y el compilador lo puede vectorizar.
+//
+// nombre_agregar_lote verifica una sola vez para todo el lote y copia con
+// un for sin condiciones adentro, que también se vectoriza.
+//
+// Ejemplo:
+//     SECUENCIA_ESTATICA_DEFINIR(float, 1024, secuencia_float)
+//     secuencia_float sec;
+//     secuencia_float_crear(&sec);
+//     secuencia_float_agregar(&sec, 3.5f);
+//     for (int i = 0; i < secuencia_float_longitud(&sec); i++) {
+//         suma += secuencia_float_obtener_sin_verificar(&sec, i);
+//     }
+
+#ifndef SECUENCIA_ESTATICA_GENERICA_H
+#define SECUENCIA_ESTATICA_GENERICA_H
+
+#include <stdbool.h>
+
+#define SECUENCIA_ESTATICA_DEFINIR(tipo, capacidad, nombre)                 \
+                                                                            \
+typedef struct {                                                            \
+    tipo elementos[capacidad];                                              \
+    int longitud;                                                           \
+} nombre;                                                                   \
+                                                                            \
+/* Deja la secuencia vacía */                                               \
+static inline void nombre##_crear(nombre *sec) {                            \
+    sec->longitud = 0;                                                      \
+}                                                                           \
+                                                                            \
+/* Retorna la capacidad, fija para todas las secuencias de este tipo */     \
+static inline int nombre##_capacidad(void) {                                \
+    return (capacidad);                                                     \
+}                                                                           \
+                                                                            \
+/* Retorna la cantidad de elementos */                                      \
+static inline int nombre##_longitud(const nombre *sec) {                    \
+    return sec->longitud;                                                   \
+}                                                                           \
+                                                                            \
+/* Verifica si está llena */                                                \
+static inline bool nombre##_llena(const nombre *sec) {                      \
+    return sec->longitud >= (capacidad);                                    \
+}                                                                           \
+                                                                            \
+/* Agrega un elemento al final; false si está llena */                      \
+static inline bool nombre##_agregar(nombre *sec, tipo valor) {              \
+    if (nombre##_llena(sec)) {                                              \
+        return false;                                                       \
+    }                                                                       \
+    sec->elementos[sec->longitud] = valor;                                  \
+    sec->longitud++;                                                        \
+    return true;                                                            \
+}                                                                           \
+                                                                            \
+/* Agrega un elemento al final; tiene que haber lugar */                    \
+static inline void nombre##_agregar_sin_verificar(nombre *sec,              \
+                                                  tipo valor) {             \
+    sec->elementos[sec->longitud] = valor;                                  \
+    sec->longitud++;                                                        \
+}                                                                           \
+                                                                            \
+/* Agrega cantidad elementos de valores; false (sin agregar ninguno) si    \
+   no entran todos */                                                       \
+static inline bool nombre##_agregar_lote(nombre *sec, const tipo *valores,  \
+                                         int cantidad) {                    \
+    if (cantidad < 0 || cantidad > (capacidad) - sec->longitud) {           \
+        return false;                                                       \
+    }                                                                       \
+    tipo *destino = sec->elementos + sec->longitud;                         \
+    for (int i = 0; i < cantidad; i++) {                                    \
+        destino[i] = valores[i];                                            \
+    }                                                                       \
+    sec->longitud += cantidad;                                              \
+    return true;                                                            \
+}                                                                           \
+                                                                            \
+/* Obtiene un elemento por índice; false si el índice no es válido */      \
+static inline bool nombre##_obtener(const nombre *sec, int indice,          \
+                                    tipo *valor) {                          \
+    if (indice < 0 || indice >= sec->longitud) {                            \
+        return false;                                                       \
+    }                                                                       \
+    *valor = sec->elementos[indice];                                        \
+    return true;                                                            \
+}                                                                           \
+                                                                            \
+/* Retorna el elemento de indice; el índice tiene que ser válido */         \
+static inline tipo nombre##_obtener_sin_verificar(const nombre *sec,        \
+                                                  int indice) {             \
+    return sec->elementos[indice];                                          \
+}                                                                           \
+                                                                            \
+/* Modifica un elemento por índice; false si el índice no es válido */     \
+static inline bool nombre##_modificar(nombre *sec, int indice,              \
+                                      tipo valor) {                         \
+    if (indice < 0 || indice >= sec->longitud) {                            \
+        return false;                                                       \
+    }                                                                       \
+    sec->elementos[indice] = valor;                                         \
+    return true;                                                            \
+}                                                                           \
+                                                                            \
+/* Modifica el elemento de indice; el índice tiene que ser válido */        \
+static inline void nombre##_modificar_sin_verificar(nombre *sec,            \
+                                                    int indice,             \
+                                                    tipo valor) {           \
+    sec->elementos[indice] = valor;                                         \
+}
+
+#endif // SECUENCIA_ESTATICA_GENERICA_H
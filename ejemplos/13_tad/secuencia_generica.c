@@ -0,0 +1,244 @@
+// TAD Secuencia genérica - Generada con macros vs. void*
+// Usa secuencia_generica.h para crear secuencias de double y de struct, y
+// las compara con una secuencia genérica basada en void* y memcpy
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "secuencia_generica.h"
+
+#define ELEMENTOS_BENCHMARK 10000000
+
+typedef struct {
+    double x;
+    double y;
+    double z;
+} Punto;
+
+SECUENCIA_DEFINIR(double, secuencia_double)
+SECUENCIA_DEFINIR(Punto, secuencia_punto)
+
+// Secuencia genérica en tiempo de ejecución: guarda bytes y el tamaño de
+// cada elemento, por lo que toda copia pasa por memcpy
+typedef struct {
+    void *elementos;
+    size_t tamano_elemento;
+    int longitud;
+    int capacidad;
+} SecuenciaGenerica;
+
+// Crea una secuencia vacía para elementos de tamano_elemento bytes
+SecuenciaGenerica *secuencia_generica_crear(size_t tamano_elemento) {
+    SecuenciaGenerica *sec = malloc(sizeof(SecuenciaGenerica));
+    if (sec == NULL) {
+        return NULL;
+    }
+    
+    sec->elementos = malloc(SECUENCIA_GENERICA_CAPACIDAD_INICIAL * tamano_elemento);
+    if (sec->elementos == NULL) {
+        free(sec);
+        return NULL;
+    }
+    
+    sec->tamano_elemento = tamano_elemento;
+    sec->longitud = 0;
+    sec->capacidad = SECUENCIA_GENERICA_CAPACIDAD_INICIAL;
+    return sec;
+}
+
+// Destruye la secuencia
+void secuencia_generica_destruir(SecuenciaGenerica *sec) {
+    if (sec != NULL) {
+        free(sec->elementos);
+        free(sec);
+    }
+}
+
+// Agrega una copia de *valor al final
+bool secuencia_generica_agregar(SecuenciaGenerica *sec, const void *valor) {
+    if (sec->longitud >= sec->capacidad) {
+        int nueva_capacidad = sec->capacidad * 2;
+        void *nuevos = realloc(sec->elementos,
+                               nueva_capacidad * sec->tamano_elemento);
+        if (nuevos == NULL) {
+            return false;
+        }
+        sec->elementos = nuevos;
+        sec->capacidad = nueva_capacidad;
+    }
+    
+    char *destino = (char *)sec->elementos + sec->longitud * sec->tamano_elemento;
+    memcpy(destino, valor, sec->tamano_elemento);
+    sec->longitud++;
+    return true;
+}
+
+// Copia el elemento en indice a *valor
+bool secuencia_generica_obtener(const SecuenciaGenerica *sec, int indice,
+                                void *valor) {
+    if (indice < 0 || indice >= sec->longitud) {
+        return false;
+    }
+    const char *origen = (const char *)sec->elementos + indice * sec->tamano_elemento;
+    memcpy(valor, origen, sec->tamano_elemento);
+    return true;
+}
+
+// Una biblioteca void* real vive en otra unidad de compilación y el
+// compilador no puede integrar sus funciones ni conocer el tamaño del
+// elemento. Llamarlas a través de punteros volatile reproduce esa situación
+// aunque estén en este mismo archivo.
+typedef bool (*FuncionAgregar)(SecuenciaGenerica *, const void *);
+typedef bool (*FuncionObtener)(const SecuenciaGenerica *, int, void *);
+
+static double segundos_desde(clock_t inicio) {
+    return (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+static void benchmark_double(int n) {
+    FuncionAgregar volatile agregar_generico = secuencia_generica_agregar;
+    FuncionObtener volatile obtener_generico = secuencia_generica_obtener;
+    
+    clock_t inicio = clock();
+    secuencia_double *tipada = secuencia_double_crear();
+    for (int i = 0; i < n; i++) {
+        secuencia_double_agregar(tipada, i * 0.5);
+    }
+    double suma_tipada = 0.0;
+    for (int i = 0; i < n; i++) {
+        double valor = 0.0;
+        secuencia_double_obtener(tipada, i, &valor);
+        suma_tipada += valor;
+    }
+    secuencia_double_destruir(tipada);
+    double t_tipada = segundos_desde(inicio);
+    
+    inicio = clock();
+    SecuenciaGenerica *generica = secuencia_generica_crear(sizeof(double));
+    for (int i = 0; i < n; i++) {
+        double valor = i * 0.5;
+        agregar_generico(generica, &valor);
+    }
+    double suma_generica = 0.0;
+    for (int i = 0; i < n; i++) {
+        double valor = 0.0;
+        obtener_generico(generica, i, &valor);
+        suma_generica += valor;
+    }
+    secuencia_generica_destruir(generica);
+    double t_generica = segundos_desde(inicio);
+    
+    printf("%-8s %14.1f %14.1f %8.1fx %s\n", "double",
+           n / t_tipada / 1e6, n / t_generica / 1e6, t_generica / t_tipada,
+           suma_tipada == suma_generica ? "" : "(¡sumas distintas!)");
+}
+
+static void benchmark_punto(int n) {
+    FuncionAgregar volatile agregar_generico = secuencia_generica_agregar;
+    FuncionObtener volatile obtener_generico = secuencia_generica_obtener;
+    
+    clock_t inicio = clock();
+    secuencia_punto *tipada = secuencia_punto_crear();
+    for (int i = 0; i < n; i++) {
+        Punto p = {i, i * 2.0, i * 3.0};
+        secuencia_punto_agregar(tipada, p);
+    }
+    double suma_tipada = 0.0;
+    for (int i = 0; i < n; i++) {
+        Punto p = {0.0, 0.0, 0.0};
+        secuencia_punto_obtener(tipada, i, &p);
+        suma_tipada += p.x + p.y + p.z;
+    }
+    secuencia_punto_destruir(tipada);
+    double t_tipada = segundos_desde(inicio);
+    
+    inicio = clock();
+    SecuenciaGenerica *generica = secuencia_generica_crear(sizeof(Punto));
+    for (int i = 0; i < n; i++) {
+        Punto p = {i, i * 2.0, i * 3.0};
+        agregar_generico(generica, &p);
+    }
+    double suma_generica = 0.0;
+    for (int i = 0; i < n; i++) {
+        Punto p = {0.0, 0.0, 0.0};
+        obtener_generico(generica, i, &p);
+        suma_generica += p.x + p.y + p.z;
+    }
+    secuencia_generica_destruir(generica);
+    double t_generica = segundos_desde(inicio);
+    
+    printf("%-8s %14.1f %14.1f %8.1fx %s\n", "Punto",
+           n / t_tipada / 1e6, n / t_generica / 1e6, t_generica / t_tipada,
+           suma_tipada == suma_generica ? "" : "(¡sumas distintas!)");
+}
+
+// Agrega y recorre n elementos con ambas versiones (millones por segundo)
+static void benchmark(int n) {
+    printf("Agregar y recorrer %d elementos\n", n);
+    printf("%-8s %14s %14s %9s\n", "tipo", "macro (M/s)", "void* (M/s)",
+           "mejora");
+    benchmark_double(n);
+    benchmark_punto(n);
+}
+
+static int demostracion(void) {
+    secuencia_double *temperaturas = secuencia_double_crear();
+    secuencia_punto *recorrido = secuencia_punto_crear();
+    if (temperaturas == NULL || recorrido == NULL) {
+        fprintf(stderr, "Error al crear las secuencias\n");
+        secuencia_double_destruir(temperaturas);
+        secuencia_punto_destruir(recorrido);
+        return 1;
+    }
+    
+    for (int i = 0; i < 6; i++) {
+        secuencia_double_agregar(temperaturas, 18.5 + i * 1.25);
+        Punto p = {i, i * i, 0.0};
+        secuencia_punto_agregar(recorrido, p);
+    }
+    
+    printf("Temperaturas: ");
+    for (int i = 0; i < secuencia_double_longitud(temperaturas); i++) {
+        double t = 0.0;
+        secuencia_double_obtener(temperaturas, i, &t);
+        printf("%.2f ", t);
+    }
+    printf("\n");
+    
+    printf("Recorrido: ");
+    for (int i = 0; i < secuencia_punto_longitud(recorrido); i++) {
+        Punto p = {0.0, 0.0, 0.0};
+        secuencia_punto_obtener(recorrido, i, &p);
+        printf("(%.0f, %.0f) ", p.x, p.y);
+    }
+    printf("\n");
+    
+    secuencia_double_destruir(temperaturas);
+    secuencia_punto_destruir(recorrido);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        return demostracion();
+    }
+    
+    if (strcmp(argv[1], "benchmark") == 0) {
+        int n = ELEMENTOS_BENCHMARK;
+        if (argc == 3) {
+            n = atoi(argv[2]);
+        }
+        if (n <= 0) {
+            fprintf(stderr, "La cantidad de elementos debe ser positiva\n");
+            return 1;
+        }
+        benchmark(n);
+        return 0;
+    }
+    
+    printf("Uso: %s [benchmark [elementos]]\n", argv[0]);
+    return 1;
+}
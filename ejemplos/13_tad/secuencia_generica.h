@@ -0,0 +1,98 @@
+// TAD Secuencia genérica generada con macros
+//
+// SECUENCIA_DEFINIR(tipo, nombre) genera el tipo `nombre` y las funciones
+// nombre_crear, nombre_destruir, nombre_agregar, nombre_obtener y
+// nombre_longitud, todas trabajando directamente con `tipo`.
+//
+// A diferencia de una secuencia con void* y tamaño de elemento en tiempo de
+// ejecución, cada copia es una asignación del tipo concreto: el compilador
+// la resuelve en línea (un registro para un double, unas pocas
+// instrucciones para un struct) sin llamar a memcpy.
+//
+// Ejemplo:
+//     SECUENCIA_DEFINIR(double, secuencia_double)
+//     secuencia_double *sec = secuencia_double_crear();
+//     secuencia_double_agregar(sec, 3.14);
+
+#ifndef SECUENCIA_GENERICA_H
+#define SECUENCIA_GENERICA_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#define SECUENCIA_GENERICA_CAPACIDAD_INICIAL 4
+
+#define SECUENCIA_DEFINIR(tipo, nombre)                                     \
+                                                                            \
+typedef struct {                                                            \
+    tipo *elementos;                                                        \
+    int longitud;                                                           \
+    int capacidad;                                                          \
+} nombre;                                                                   \
+                                                                            \
+/* Crea una secuencia vacía; retorna NULL si no hay memoria */              \
+static inline nombre *nombre##_crear(void) {                                \
+    nombre *sec = malloc(sizeof(nombre));                                   \
+    if (sec == NULL) {                                                      \
+        return NULL;                                                        \
+    }                                                                       \
+    sec->elementos =                                                        \
+        malloc(SECUENCIA_GENERICA_CAPACIDAD_INICIAL * sizeof(tipo));        \
+    if (sec->elementos == NULL) {                                           \
+        free(sec);                                                          \
+        return NULL;                                                        \
+    }                                                                       \
+    sec->longitud = 0;                                                      \
+    sec->capacidad = SECUENCIA_GENERICA_CAPACIDAD_INICIAL;                  \
+    return sec;                                                             \
+}                                                                           \
+                                                                            \
+/* Destruye la secuencia (acepta NULL) */                                   \
+static inline void nombre##_destruir(nombre *sec) {                         \
+    if (sec != NULL) {                                                      \
+        free(sec->elementos);                                               \
+        free(sec);                                                          \
+    }                                                                       \
+}                                                                           \
+                                                                            \
+/* Duplica la capacidad; queda fuera del camino rápido de agregar */        \
+static bool nombre##_redimensionar(nombre *sec) {                           \
+    int nueva_capacidad = sec->capacidad * 2;                               \
+    tipo *nuevos_elementos =                                                \
+        realloc(sec->elementos, nueva_capacidad * sizeof(tipo));            \
+    if (nuevos_elementos == NULL) {                                         \
+        return false;                                                       \
+    }                                                                       \
+    sec->elementos = nuevos_elementos;                                      \
+    sec->capacidad = nueva_capacidad;                                       \
+    return true;                                                            \
+}                                                                           \
+                                                                            \
+/* Agrega un elemento al final */                                           \
+static inline bool nombre##_agregar(nombre *sec, tipo valor) {              \
+    if (sec->longitud >= sec->capacidad) {                                  \
+        if (!nombre##_redimensionar(sec)) {                                 \
+            return false;                                                   \
+        }                                                                   \
+    }                                                                       \
+    sec->elementos[sec->longitud] = valor;                                  \
+    sec->longitud++;                                                        \
+    return true;                                                            \
+}                                                                           \
+                                                                            \
+/* Obtiene un elemento por índice */                                        \
+static inline bool nombre##_obtener(const nombre *sec, int indice,          \
+                                    tipo *valor) {                          \
+    if (indice < 0 || indice >= sec->longitud) {                            \
+        return false;                                                       \
+    }                                                                       \
+    *valor = sec->elementos[indice];                                        \
+    return true;                                                            \
+}                                                                           \
+                                                                            \
+/* Retorna la cantidad de elementos */                                      \
+static inline int nombre##_longitud(const nombre *sec) {                    \
+    return sec->longitud;                                                   \
+}
+
+#endif // SECUENCIA_GENERICA_H
@@ -0,0 +1,273 @@
+// TAD Secuencia - Implementación Segmentada
+// Guarda los elementos en segmentos de tamaño fijo (potencia de dos) a los
+// que apunta un directorio. Crecer solo agrega un segmento: los elementos
+// nunca se mueven, así que no hay copias grandes y los punteros a ellos
+// siguen siendo válidos mientras la secuencia exista.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "escritor.h"
+
+// Cada segmento guarda 2^BITS_SEGMENTO elementos (4 KiB de int)
+#define BITS_SEGMENTO 10
+#define TAMANO_SEGMENTO (1 << BITS_SEGMENTO)
+#define MASCARA_SEGMENTO (TAMANO_SEGMENTO - 1)
+#define DIRECTORIO_INICIAL 4
+
+#define ELEMENTOS_BENCHMARK 10000000
+
+typedef struct {
+    int **segmentos;        // Directorio: segmentos[i] apunta a un bloque
+    int cantidad_segmentos; // Segmentos reservados
+    int capacidad_directorio;
+    int longitud;
+} Secuencia;
+
+// Crea una secuencia vacía
+Secuencia *secuencia_crear(void) {
+    Secuencia *sec = malloc(sizeof(Secuencia));
+    if (sec == NULL) {
+        return NULL;
+    }
+    
+    sec->segmentos = malloc(DIRECTORIO_INICIAL * sizeof(int *));
+    if (sec->segmentos == NULL) {
+        free(sec);
+        return NULL;
+    }
+    
+    sec->cantidad_segmentos = 0;
+    sec->capacidad_directorio = DIRECTORIO_INICIAL;
+    sec->longitud = 0;
+    return sec;
+}
+
+// Destruye la secuencia
+void secuencia_destruir(Secuencia *sec) {
+    if (sec != NULL) {
+        for (int i = 0; i < sec->cantidad_segmentos; i++) {
+            free(sec->segmentos[i]);
+        }
+        free(sec->segmentos);
+        free(sec);
+    }
+}
+
+// Agrega un segmento al final del directorio
+// Si el directorio está lleno se duplica: solo se copian punteros
+static bool secuencia_agregar_segmento(Secuencia *sec) {
+    if (sec->cantidad_segmentos >= sec->capacidad_directorio) {
+        int nueva_capacidad = sec->capacidad_directorio * 2;
+        int **nuevo_directorio = realloc(sec->segmentos,
+                                         nueva_capacidad * sizeof(int *));
+        if (nuevo_directorio == NULL) {
+            return false;
+        }
+        sec->segmentos = nuevo_directorio;
+        sec->capacidad_directorio = nueva_capacidad;
+    }
+    
+    int *segmento = malloc(TAMANO_SEGMENTO * sizeof(int));
+    if (segmento == NULL) {
+        return false;
+    }
+    
+    sec->segmentos[sec->cantidad_segmentos] = segmento;
+    sec->cantidad_segmentos++;
+    return true;
+}
+
+// Agrega un elemento al final
+bool secuencia_agregar(Secuencia *sec, int valor) {
+    int segmento = sec->longitud >> BITS_SEGMENTO;
+    if (segmento >= sec->cantidad_segmentos) {
+        if (!secuencia_agregar_segmento(sec)) {
+            return false;
+        }
+    }
+    
+    sec->segmentos[segmento][sec->longitud & MASCARA_SEGMENTO] = valor;
+    sec->longitud++;
+    return true;
+}
+
+// Obtiene un elemento por índice en O(1): un desplazamiento y una máscara
+bool secuencia_obtener(const Secuencia *sec, int indice, int *valor) {
+    if (indice < 0 || indice >= sec->longitud) {
+        return false;
+    }
+    *valor = sec->segmentos[indice >> BITS_SEGMENTO][indice & MASCARA_SEGMENTO];
+    return true;
+}
+
+// Retorna la dirección del elemento en indice, o NULL si está fuera de rango
+// La dirección no cambia al agregar más elementos
+int *secuencia_referencia(Secuencia *sec, int indice) {
+    if (indice < 0 || indice >= sec->longitud) {
+        return NULL;
+    }
+    return &sec->segmentos[indice >> BITS_SEGMENTO][indice & MASCARA_SEGMENTO];
+}
+
+// Retorna la longitud actual
+int secuencia_longitud(const Secuencia *sec) {
+    return sec->longitud;
+}
+
+// Imprime la secuencia
+void secuencia_imprimir(const Secuencia *sec) {
+    Escritor escritor;
+    escritor_iniciar(&escritor, stdout);
+    escritor_cadena(&escritor, "[");
+    for (int i = 0; i < sec->longitud; i++) {
+        int valor;
+        secuencia_obtener(sec, i, &valor);
+        escritor_entero(&escritor, valor);
+        if (i < sec->longitud - 1) {
+            escritor_cadena(&escritor, ", ");
+        }
+    }
+    escritor_cadena(&escritor, "] (segmentos: ");
+    escritor_entero(&escritor, sec->cantidad_segmentos);
+    escritor_cadena(&escritor, ")\n");
+    escritor_vaciar(&escritor);
+}
+
+// Referencia para el benchmark: la secuencia dinámica de
+// secuencia_dinamica.c, que duplica un único arreglo con realloc
+typedef struct {
+    int *elementos;
+    int longitud;
+    int capacidad;
+} SecuenciaDinamica;
+
+static bool secuencia_dinamica_agregar(SecuenciaDinamica *sec, int valor) {
+    if (sec->longitud >= sec->capacidad) {
+        int nueva_capacidad = sec->capacidad * 2;
+        int *nuevos = realloc(sec->elementos, nueva_capacidad * sizeof(int));
+        if (nuevos == NULL) {
+            return false;
+        }
+        sec->elementos = nuevos;
+        sec->capacidad = nueva_capacidad;
+    }
+    sec->elementos[sec->longitud] = valor;
+    sec->longitud++;
+    return true;
+}
+
+static long long nanosegundos(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int comparar_long_long(const void *a, const void *b) {
+    long long x = *(const long long *)a;
+    long long y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+// Ordena las latencias e imprime sus percentiles
+static void imprimir_percentiles(const char *nombre, long long *latencias,
+                                 int n) {
+    qsort(latencias, n, sizeof(long long), comparar_long_long);
+    printf("%-12s %8lld %8lld %8lld %12lld\n", nombre,
+           latencias[n / 2], latencias[(int)(n * 0.99)],
+           latencias[(int)(n * 0.999)], latencias[n - 1]);
+}
+
+// Mide la latencia de cada agregado (en ns) con ambas implementaciones
+static int benchmark_latencia(int n) {
+    long long *latencias = malloc(n * sizeof(long long));
+    SecuenciaDinamica dinamica = {malloc(4 * sizeof(int)), 0, 4};
+    Secuencia *segmentada = secuencia_crear();
+    if (latencias == NULL || dinamica.elementos == NULL || segmentada == NULL) {
+        fprintf(stderr, "No hay memoria para el benchmark\n");
+        free(latencias);
+        free(dinamica.elementos);
+        secuencia_destruir(segmentada);
+        return 1;
+    }
+    
+    printf("Latencia de %d agregados (ns)\n", n);
+    printf("%-12s %8s %8s %8s %12s\n", "secuencia", "p50", "p99", "p99.9",
+           "máximo");
+    
+    for (int i = 0; i < n; i++) {
+        long long inicio = nanosegundos();
+        secuencia_dinamica_agregar(&dinamica, i);
+        latencias[i] = nanosegundos() - inicio;
+    }
+    imprimir_percentiles("dinámica", latencias, n);
+    free(dinamica.elementos);
+    
+    for (int i = 0; i < n; i++) {
+        long long inicio = nanosegundos();
+        secuencia_agregar(segmentada, i);
+        latencias[i] = nanosegundos() - inicio;
+    }
+    imprimir_percentiles("segmentada", latencias, n);
+    secuencia_destruir(segmentada);
+    
+    free(latencias);
+    return 0;
+}
+
+static int demostracion(void) {
+    Secuencia *mi_secuencia = secuencia_crear();
+    if (mi_secuencia == NULL) {
+        fprintf(stderr, "Error al crear la secuencia\n");
+        return 1;
+    }
+    
+    for (int i = 1; i <= 10; i++) {
+        secuencia_agregar(mi_secuencia, i * 10);
+    }
+    secuencia_imprimir(mi_secuencia);
+    
+    // Una dirección tomada ahora sigue siendo válida después de crecer
+    int *tercero = secuencia_referencia(mi_secuencia, 2);
+    printf("\nAgregando %d elementos más...\n", 5 * TAMANO_SEGMENTO);
+    for (int i = 0; i < 5 * TAMANO_SEGMENTO; i++) {
+        secuencia_agregar(mi_secuencia, i);
+    }
+    printf("Longitud: %d, segmentos: %d\n", secuencia_longitud(mi_secuencia),
+           mi_secuencia->cantidad_segmentos);
+    printf("El tercer elemento sigue en la misma dirección: %d (%s)\n",
+           *tercero,
+           tercero == secuencia_referencia(mi_secuencia, 2) ? "sí" : "no");
+    
+    int valor;
+    if (secuencia_obtener(mi_secuencia, 3000, &valor)) {
+        printf("Elemento en índice 3000: %d\n", valor);
+    }
+    
+    secuencia_destruir(mi_secuencia);
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        return demostracion();
+    }
+    
+    if (strcmp(argv[1], "latencia") == 0) {
+        int n = ELEMENTOS_BENCHMARK;
+        if (argc == 3) {
+            n = atoi(argv[2]);
+        }
+        if (n <= 0) {
+            fprintf(stderr, "La cantidad de elementos debe ser positiva\n");
+            return 1;
+        }
+        return benchmark_latencia(n);
+    }
+    
+    printf("Uso: %s [latencia [elementos]]\n", argv[0]);
+    return 1;
+}
@@ -1,9 +1,17 @@
 // Calculadora RPN usando una pila
+//
+// Compilar con: gcc -Wall -Wextra -std=c11 -pedantic -pthread pila_calculadora.c
+
+#define _POSIX_C_SOURCE 200809L
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
 #include <ctype.h>
 #include <string.h>
+#include <time.h>
+#include <pthread.h>
 
 #define MAX_PILA 100
 
@@ -40,84 +48,2233 @@ int pila_pop(Pila *p, double *valor) {
     return 1;
 }
 
+// Sin verificar: quien llama garantiza que hay lugar
+void pila_push_sin_verificar(Pila *p, double valor) {
+    p->elementos[++(p->tope)] = valor;
+}
+
+// Sin verificar: quien llama garantiza que la pila no está vacía
+double pila_pop_sin_verificar(Pila *p) {
+    return p->elementos[(p->tope)--];
+}
+
+// Tokenizador
+//
+// Recorre la expresión con un puntero, sin copiarla ni modificarla: cada
+// token queda como su inicio dentro del texto más su largo, y los números
+// se convierten en el lugar con strtod, que deja en fin dónde terminó el
+// número. Toda la posición vive en el cursor de quien llama, así que
+// varios hilos pueden tokenizar a la vez; strtok, en cambio, la guarda en
+// una variable estática y además necesita una copia modificable del texto.
+
+typedef enum {
+    TOKEN_NUMERO,
+    TOKEN_OPERADOR,
+    TOKEN_NOMBRE,
+    TOKEN_FIN,
+    TOKEN_INVALIDO
+} TipoToken;
+
+typedef struct {
+    TipoToken tipo;
+    const char *inicio;     // Apunta dentro de la expresión
+    int largo;
+    double numero;          // Valor, si es TOKEN_NUMERO
+} Token;
+
+static int es_inicio_numero(const char *token) {
+    return isdigit((unsigned char)token[0]) ||
+           (token[0] == '-' && isdigit((unsigned char)token[1]));
+}
+
+static int es_nombre(const char *token, int largo) {
+    if (!isalpha((unsigned char)token[0]) && token[0] != '_') {
+        return 0;
+    }
+    for (int i = 1; i < largo; i++) {
+        if (!isalnum((unsigned char)token[i]) && token[i] != '_') {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Lee el token que sigue a *cursor, saltando espacios, y deja el cursor
+// justo después. Al final del texto da TOKEN_FIN.
+static void siguiente_token(const char **cursor, Token *token) {
+    const char *actual = *cursor;
+    while (isspace((unsigned char)*actual)) {
+        actual++;
+    }
+    token->inicio = actual;
+    if (*actual == '\0') {
+        token->tipo = TOKEN_FIN;
+        token->largo = 0;
+        *cursor = actual;
+        return;
+    }
+    while (*actual != '\0' && !isspace((unsigned char)*actual)) {
+        actual++;
+    }
+    token->largo = (int)(actual - token->inicio);
+    *cursor = actual;
+    
+    if (es_inicio_numero(token->inicio)) {
+        // strtod no pasa de un espacio, pero puede cortar antes ("3x")
+        char *fin;
+        token->numero = strtod(token->inicio, &fin);
+        token->tipo = fin == actual ? TOKEN_NUMERO : TOKEN_INVALIDO;
+    } else if (token->largo == 1 && strchr("+-*/", token->inicio[0]) != NULL) {
+        token->tipo = TOKEN_OPERADOR;
+    } else if (es_nombre(token->inicio, token->largo)) {
+        token->tipo = TOKEN_NOMBRE;
+    } else {
+        token->tipo = TOKEN_INVALIDO;
+    }
+}
+
 // Calculadora RPN (Reverse Polish Notation)
 // Ejemplo: "3 4 + 2 *" = (3 + 4) * 2 = 14
-int evaluar_rpn(const char *expresion, double *resultado) {
+//
+// Si falla y posicion_error no es NULL, deja ahí dónde se detectó el
+// error, como índice en la expresión: el inicio del token inválido, del
+// operador sin operandos suficientes o de la división por cero, o el
+// largo de la expresión si al final no queda exactamente un valor.
+int evaluar_rpn_posicion(const char *expresion, double *resultado,
+                         int *posicion_error) {
     Pila pila;
     pila_inicializar(&pila);
     
-    char *copia = strdup(expresion);
-    char *token = strtok(copia, " ");
-    
-    while (token != NULL) {
-        if (isdigit(token[0]) || (token[0] == '-' && isdigit(token[1]))) {
-            // Es un número
-            double num = atof(token);
-            pila_push(&pila, num);
-        } else {
-            // Es un operador
+    const char *cursor = expresion;
+    Token token;
+    for (siguiente_token(&cursor, &token); token.tipo != TOKEN_FIN;
+         siguiente_token(&cursor, &token)) {
+        int ok = 1;
+        if (token.tipo == TOKEN_NUMERO) {
+            ok = pila_push(&pila, token.numero);
+        } else if (token.tipo == TOKEN_OPERADOR) {
             double b, a;
             if (!pila_pop(&pila, &b) || !pila_pop(&pila, &a)) {
-                free(copia);
-                return 0;  // Error: no hay suficientes operandos
+                ok = 0;  // Error: no hay suficientes operandos
+            } else {
+                double res = 0.0;
+                switch (token.inicio[0]) {
+                    case '+': res = a + b; break;
+                    case '-': res = a - b; break;
+                    case '*': res = a * b; break;
+                    case '/':
+                        if (b == 0) {
+                            ok = 0;  // División por cero
+                        } else {
+                            res = a / b;
+                        }
+                        break;
+                }
+                ok = ok && pila_push(&pila, res);
+            }
+        } else {
+            ok = 0;  // Token no reconocido (las variables no tienen valor)
+        }
+        if (!ok) {
+            if (posicion_error != NULL) {
+                *posicion_error = (int)(token.inicio - expresion);
+            }
+            return 0;
+        }
+    }
+    
+    // Debe quedar exactamente un elemento en la pila
+    if (pila.tope != 0) {
+        if (posicion_error != NULL) {
+            *posicion_error = (int)(token.inicio - expresion);
+        }
+        return 0;
+    }
+    
+    *resultado = pila.elementos[0];
+    return 1;
+}
+
+int evaluar_rpn(const char *expresion, double *resultado) {
+    return evaluar_rpn_posicion(expresion, resultado, NULL);
+}
+
+// Programa RPN compilado
+//
+// evaluar_rpn vuelve a separar el texto en tokens y a convertir cada
+// número con strtod en cada llamada. compilar_rpn hace ese trabajo una sola
+// vez y deja un programa: un arreglo de instrucciones de 4 bytes, las
+// constantes ya convertidas a double y los nombres de las variables.
+// ejecutar_programa lo evalúa con los valores que reciba para las
+// variables, tantas veces como haga falta.
+// Ejemplo: "x 2 * y +" con x = 3, y = 1 da 7
+
+#define MAX_INSTRUCCIONES 256
+#define MAX_CONSTANTES 64
+#define MAX_VARIABLES 16
+#define MAX_NOMBRE 16
+
+typedef enum {
+    OP_CONSTANTE,    // Apila constantes[argumento]
+    OP_VARIABLE,     // Apila valores[argumento]
+    OP_SUMA,
+    OP_RESTA,
+    OP_PRODUCTO,
+    OP_DIVISION,
+    OP_FIN           // Solo en programas decodificados (ver decodificar_programa)
+} CodigoOperacion;
+
+typedef struct {
+    uint8_t codigo;         // Un CodigoOperacion
+    uint16_t argumento;     // Índice de la constante o de la variable
+} Instruccion;
+
+typedef struct {
+    Instruccion instrucciones[MAX_INSTRUCCIONES];
+    int cantidad;
+    double constantes[MAX_CONSTANTES];
+    int cantidad_constantes;
+    char variables[MAX_VARIABLES][MAX_NOMBRE];
+    int cantidad_variables;
+    int profundidad;        // Máxima de la pila, o 0 si no se calculó
+} Programa;
+
+// Retorna el índice de la variable nombre en el programa, o -1 si no está
+int programa_variable(const Programa *programa, const char *nombre) {
+    for (int i = 0; i < programa->cantidad_variables; i++) {
+        if (strcmp(programa->variables[i], nombre) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int programa_agregar(Programa *programa, CodigoOperacion codigo,
+                            int argumento) {
+    if (programa->cantidad >= MAX_INSTRUCCIONES) {
+        return 0;
+    }
+    programa->instrucciones[programa->cantidad].codigo = (uint8_t)codigo;
+    programa->instrucciones[programa->cantidad].argumento = (uint16_t)argumento;
+    programa->cantidad++;
+    return 1;
+}
+
+// Agrega la instrucción que apila la variable de largo caracteres que
+// empieza en token, registrándola si es nueva
+static int programa_agregar_variable(Programa *programa, const char *token,
+                                     int largo) {
+    if (largo >= MAX_NOMBRE) {
+        return 0;
+    }
+    char nombre[MAX_NOMBRE];
+    memcpy(nombre, token, largo);
+    nombre[largo] = '\0';
+    
+    int indice = programa_variable(programa, nombre);
+    if (indice < 0) {
+        if (programa->cantidad_variables >= MAX_VARIABLES) {
+            return 0;
+        }
+        indice = programa->cantidad_variables;
+        strcpy(programa->variables[indice], nombre);
+        programa->cantidad_variables++;
+    }
+    return programa_agregar(programa, OP_VARIABLE, indice);
+}
+
+// Compila una expresión RPN con números, variables (letras, dígitos y _,
+// empezando por letra o _) y los operadores + - * /
+// Retorna 0 si hay un token inválido o el programa no entra en los
+// límites; en ese caso, si posicion_error no es NULL, deja ahí el índice
+// en la expresión del token que falló.
+int compilar_rpn_posicion(const char *expresion, Programa *programa,
+                          int *posicion_error) {
+    programa->cantidad = 0;
+    programa->cantidad_constantes = 0;
+    programa->cantidad_variables = 0;
+    programa->profundidad = 0;
+    
+    const char *cursor = expresion;
+    Token token;
+    for (siguiente_token(&cursor, &token); token.tipo != TOKEN_FIN;
+         siguiente_token(&cursor, &token)) {
+        int ok = 0;
+        if (token.tipo == TOKEN_NUMERO) {
+            if (programa->cantidad_constantes < MAX_CONSTANTES) {
+                programa->constantes[programa->cantidad_constantes] =
+                    token.numero;
+                ok = programa_agregar(programa, OP_CONSTANTE,
+                                      programa->cantidad_constantes);
+                programa->cantidad_constantes++;
+            }
+        } else if (token.tipo == TOKEN_OPERADOR) {
+            CodigoOperacion codigo = OP_SUMA;
+            switch (token.inicio[0]) {
+                case '+': codigo = OP_SUMA; break;
+                case '-': codigo = OP_RESTA; break;
+                case '*': codigo = OP_PRODUCTO; break;
+                case '/': codigo = OP_DIVISION; break;
             }
-            
-            double res;
-            switch (token[0]) {
-                case '+': res = a + b; break;
-                case '-': res = a - b; break;
-                case '*': res = a * b; break;
-                case '/': 
-                    if (b == 0) {
-                        free(copia);
-                        return 0;  // División por cero
-                    }
-                    res = a / b;
-                    break;
-                default:
-                    free(copia);
-                    return 0;  // Operador no reconocido
+            ok = programa_agregar(programa, codigo, 0);
+        } else if (token.tipo == TOKEN_NOMBRE) {
+            ok = programa_agregar_variable(programa, token.inicio,
+                                           token.largo);
+        }
+        if (!ok) {
+            if (posicion_error != NULL) {
+                *posicion_error = (int)(token.inicio - expresion);
             }
-            
-            pila_push(&pila, res);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int compilar_rpn(const char *expresion, Programa *programa) {
+    return compilar_rpn_posicion(expresion, programa, NULL);
+}
+
+// Evalúa un programa cuya profundidad ya se calculó (ver
+// optimizar_programa): como se sabe que entra en la pila, que a ningún
+// operador le faltan operandos y que al final queda un valor, solo queda
+// verificar la división por cero
+static int ejecutar_programa_sin_verificar(const Programa *programa,
+                                           const double *valores,
+                                           double *resultado) {
+    Pila pila;
+    pila_inicializar(&pila);
+    
+    for (int i = 0; i < programa->cantidad; i++) {
+        Instruccion instruccion = programa->instrucciones[i];
+        if (instruccion.codigo == OP_CONSTANTE) {
+            pila_push_sin_verificar(&pila,
+                                    programa->constantes[instruccion.argumento]);
+            continue;
+        }
+        if (instruccion.codigo == OP_VARIABLE) {
+            pila_push_sin_verificar(&pila, valores[instruccion.argumento]);
+            continue;
         }
         
-        token = strtok(NULL, " ");
+        double b = pila_pop_sin_verificar(&pila);
+        double a = pila_pop_sin_verificar(&pila);
+        double res = 0.0;
+        switch (instruccion.codigo) {
+            case OP_SUMA: res = a + b; break;
+            case OP_RESTA: res = a - b; break;
+            case OP_PRODUCTO: res = a * b; break;
+            case OP_DIVISION:
+                if (b == 0) {
+                    return 0;  // División por cero
+                }
+                res = a / b;
+                break;
+        }
+        pila_push_sin_verificar(&pila, res);
+    }
+    *resultado = pila.elementos[0];
+    return 1;
+}
+
+// Evalúa un programa compilado; valores[i] es el valor de la variable i
+// (ver programa_variable). Los errores son los mismos que en evaluar_rpn.
+// Si optimizar_programa ya calculó la profundidad, se evalúa sin verificar
+// la pila en cada paso.
+int ejecutar_programa(const Programa *programa, const double *valores,
+                      double *resultado) {
+    if (programa->profundidad > 0) {
+        return ejecutar_programa_sin_verificar(programa, valores, resultado);
     }
     
-    free(copia);
+    Pila pila;
+    pila_inicializar(&pila);
+    
+    for (int i = 0; i < programa->cantidad; i++) {
+        Instruccion instruccion = programa->instrucciones[i];
+        if (instruccion.codigo == OP_CONSTANTE) {
+            if (!pila_push(&pila, programa->constantes[instruccion.argumento])) {
+                return 0;
+            }
+            continue;
+        }
+        if (instruccion.codigo == OP_VARIABLE) {
+            if (!pila_push(&pila, valores[instruccion.argumento])) {
+                return 0;
+            }
+            continue;
+        }
+        
+        double b, a;
+        if (!pila_pop(&pila, &b) || !pila_pop(&pila, &a)) {
+            return 0;  // Error: no hay suficientes operandos
+        }
+        
+        double res;
+        switch (instruccion.codigo) {
+            case OP_SUMA: res = a + b; break;
+            case OP_RESTA: res = a - b; break;
+            case OP_PRODUCTO: res = a * b; break;
+            case OP_DIVISION:
+                if (b == 0) {
+                    return 0;  // División por cero
+                }
+                res = a / b;
+                break;
+            default:
+                return 0;
+        }
+        pila_push(&pila, res);
+    }
     
     // Debe quedar exactamente un elemento en la pila
     if (pila.tope != 0) {
         return 0;
     }
-    
     *resultado = pila.elementos[0];
     return 1;
 }
 
-int main(void) {
-    printf("Calculadora RPN (Reverse Polish Notation)\n\n");
+// Retorna la profundidad máxima que alcanza la pila al ejecutar el
+// programa, o -1 si le faltan operandos a algún operador o al final no
+// queda exactamente un valor
+static int programa_profundidad(const Programa *programa) {
+    int profundidad = 0;
+    int maxima = 0;
+    for (int i = 0; i < programa->cantidad; i++) {
+        CodigoOperacion codigo = programa->instrucciones[i].codigo;
+        if (codigo == OP_CONSTANTE || codigo == OP_VARIABLE) {
+            profundidad++;
+            if (profundidad > maxima) {
+                maxima = profundidad;
+            }
+        } else {
+            if (profundidad < 2) {
+                return -1;
+            }
+            profundidad--;
+        }
+    }
+    return profundidad == 1 ? maxima : -1;
+}
+
+// Optimización de programas
+//
+// optimizar_programa reescribe un programa compilado:
+// - Pliega las operaciones entre constantes: "15 7 1 1 + - /" queda como
+//   la constante 3. Una división por una constante 0 no se pliega, para
+//   que el error siga apareciendo al evaluar.
+// - Saca las operaciones neutras: x + 0, 0 + x, x - 0, x * 1, 1 * x y
+//   x / 1 quedan como x (x + 0 solo cambiaría el signo de un cero).
+// - Calcula la profundidad máxima de la pila, con lo que
+//   ejecutar_programa ya no verifica pila_llena en cada push.
+//
+// Recorre el programa con una pila simbólica: cada lugar recuerda dónde
+// empiezan en la salida las instrucciones que calculan ese valor y si es
+// una constante conocida.
+
+typedef struct {
+    int inicio;
+    int es_constante;
+    double valor;
+} ValorSimbolico;
+
+// Calcula a op b; retorna 0 si no se puede plegar (división por cero)
+static int plegar(CodigoOperacion codigo, double a, double b,
+                  double *resultado) {
+    switch (codigo) {
+        case OP_SUMA: *resultado = a + b; return 1;
+        case OP_RESTA: *resultado = a - b; return 1;
+        case OP_PRODUCTO: *resultado = a * b; return 1;
+        case OP_DIVISION:
+            if (b == 0) {
+                return 0;
+            }
+            *resultado = a / b;
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+// x op valor == x
+static int es_neutro_derecha(CodigoOperacion codigo, double valor) {
+    return ((codigo == OP_SUMA || codigo == OP_RESTA) && valor == 0) ||
+           ((codigo == OP_PRODUCTO || codigo == OP_DIVISION) && valor == 1);
+}
+
+// valor op x == x
+static int es_neutro_izquierda(CodigoOperacion codigo, double valor) {
+    return (codigo == OP_SUMA && valor == 0) ||
+           (codigo == OP_PRODUCTO && valor == 1);
+}
+
+// Retorna 0 si el programa está mal formado (ver programa_profundidad)
+int optimizar_programa(Programa *programa) {
+    if (programa_profundidad(programa) < 0) {
+        return 0;
+    }
     
-    const char *expresiones[] = {
-        "3 4 +",           // 7
-        "15 7 1 1 + - /",  // 3
-        "5 1 2 + 4 * + 3 -", // 14
-        "3 4 + 2 *"        // 14
-    };
+    Instruccion salida[MAX_INSTRUCCIONES];
+    int cantidad = 0;
+    // Cada constante que se emite ocupa un lugar nuevo; al final se
+    // compacta la tabla
+    double constantes[MAX_INSTRUCCIONES];
+    int cantidad_constantes = 0;
+    ValorSimbolico pila[MAX_INSTRUCCIONES];
+    int tope = -1;
     
-    int n = sizeof(expresiones) / sizeof(expresiones[0]);
+    for (int i = 0; i < programa->cantidad; i++) {
+        Instruccion instruccion = programa->instrucciones[i];
+        CodigoOperacion codigo = instruccion.codigo;
+        if (codigo == OP_CONSTANTE || codigo == OP_VARIABLE) {
+            tope++;
+            pila[tope].inicio = cantidad;
+            pila[tope].es_constante = codigo == OP_CONSTANTE;
+            pila[tope].valor = 0.0;
+            if (codigo == OP_CONSTANTE) {
+                pila[tope].valor = programa->constantes[instruccion.argumento];
+                constantes[cantidad_constantes] = pila[tope].valor;
+                instruccion.argumento = (uint16_t)cantidad_constantes++;
+            }
+            salida[cantidad++] = instruccion;
+            continue;
+        }
+        
+        ValorSimbolico b = pila[tope--];
+        ValorSimbolico *a = &pila[tope];
+        double plegado;
+        if (a->es_constante && b.es_constante &&
+            plegar(codigo, a->valor, b.valor, &plegado)) {
+            // Los dos operandos son las dos últimas instrucciones
+            cantidad = a->inicio;
+            a->valor = plegado;
+            constantes[cantidad_constantes] = plegado;
+            salida[cantidad].codigo = OP_CONSTANTE;
+            salida[cantidad].argumento = (uint16_t)cantidad_constantes++;
+            cantidad++;
+        } else if (b.es_constante && es_neutro_derecha(codigo, b.valor)) {
+            cantidad = b.inicio;
+        } else if (a->es_constante && es_neutro_izquierda(codigo, a->valor)) {
+            // Se saca la constante, que es la primera instrucción de a
+            memmove(&salida[a->inicio], &salida[a->inicio + 1],
+                    (cantidad - a->inicio - 1) * sizeof(Instruccion));
+            cantidad--;
+            a->es_constante = b.es_constante;
+            a->valor = b.valor;
+        } else {
+            salida[cantidad++] = instruccion;
+            a->es_constante = 0;
+        }
+    }
     
-    for (int i = 0; i < n; i++) {
-        double resultado;
-        printf("Expresión: %s\n", expresiones[i]);
+    // Quedan solo las constantes que se usan, sin repetir
+    programa->cantidad_constantes = 0;
+    for (int i = 0; i < cantidad; i++) {
+        if (salida[i].codigo != OP_CONSTANTE) {
+            continue;
+        }
+        double valor = constantes[salida[i].argumento];
+        int indice = 0;
+        // Se comparan los bits para no confundir 0 con -0
+        while (indice < programa->cantidad_constantes &&
+               memcmp(&programa->constantes[indice], &valor,
+                      sizeof(double)) != 0) {
+            indice++;
+        }
+        if (indice == programa->cantidad_constantes) {
+            programa->constantes[indice] = valor;
+            programa->cantidad_constantes++;
+        }
+        salida[i].argumento = (uint16_t)indice;
+    }
+    memcpy(programa->instrucciones, salida, cantidad * sizeof(Instruccion));
+    programa->cantidad = cantidad;
+    
+    int profundidad = programa_profundidad(programa);
+    programa->profundidad = profundidad <= MAX_PILA ? profundidad : 0;
+    return 1;
+}
+
+// Evaluación por lotes
+//
+// Para aplicar una fórmula a muchas filas, ejecutar_programa_lote evalúa
+// TAMANO_BLOQUE filas a la vez: cada lugar de la pila es un bloque de
+// valores en vez de un double, y cada instrucción recorre el bloque
+// entero. Las entradas vienen por columnas (un arreglo por variable), así
+// que apilar una variable es solo apuntar a un tramo de su columna, y cada
+// operador es un for sin condiciones sobre arreglos que no se solapan,
+// que el compilador vectoriza. Para ver esos lazos:
+//     gcc -O2 -fopt-info-vec-optimized pila_calculadora.c
+
+#define TAMANO_BLOQUE 512
+
+// destino, a y b son bloques distintos: restrict le permite al compilador
+// vectorizar sin verificar solapamientos. Siempre se opera sobre el bloque
+// completo; con una cantidad fija de vueltas GCC vectoriza también con -O2.
+static void operar_bloque(CodigoOperacion codigo, double *restrict destino,
+                          const double *restrict a,
+                          const double *restrict b) {
+    switch (codigo) {
+        case OP_SUMA:
+            for (int i = 0; i < TAMANO_BLOQUE; i++) {
+                destino[i] = a[i] + b[i];
+            }
+            break;
+        case OP_RESTA:
+            for (int i = 0; i < TAMANO_BLOQUE; i++) {
+                destino[i] = a[i] - b[i];
+            }
+            break;
+        case OP_PRODUCTO:
+            for (int i = 0; i < TAMANO_BLOQUE; i++) {
+                destino[i] = a[i] * b[i];
+            }
+            break;
+        case OP_DIVISION:
+            for (int i = 0; i < TAMANO_BLOQUE; i++) {
+                destino[i] = a[i] / b[i];
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+// Evalúa el programa sobre filas filas: columnas[v] tiene los filas
+// valores de la variable v y el resultado de la fila i queda en
+// resultados[i]. Retorna 0 si el programa está mal formado o no hay
+// memoria. A diferencia de ejecutar_programa, dividir por cero no es un
+// error: esa fila da inf o nan, como la división de double.
+int ejecutar_programa_lote(const Programa *programa,
+                           const double *const *columnas, int filas,
+                           double *resultados) {
+    int profundidad = programa_profundidad(programa);
+    if (profundidad < 0) {
+        return 0;
+    }
+    
+    // Un bloque propio por lugar de la pila, uno libre para escribir el
+    // resultado de cada operador sin pisar sus operandos y uno por
+    // variable para completar el último bloque si las filas no alcanzan
+    int variables = programa->cantidad_variables;
+    size_t bloques = (size_t)profundidad + 1 + variables;
+    double *memoria = aligned_alloc(64, bloques * TAMANO_BLOQUE *
+                                        sizeof(double));
+    const double **valores = malloc(profundidad * sizeof(double *));
+    double **propios = malloc(profundidad * sizeof(double *));
+    const double **fuentes = malloc((variables + 1) * sizeof(double *));
+    if (memoria == NULL || valores == NULL || propios == NULL ||
+        fuentes == NULL) {
+        free(memoria);
+        free(valores);
+        free(propios);
+        free(fuentes);
+        return 0;
+    }
+    for (int k = 0; k < profundidad; k++) {
+        propios[k] = memoria + (size_t)k * TAMANO_BLOQUE;
+    }
+    double *libre = memoria + (size_t)profundidad * TAMANO_BLOQUE;
+    double *colas = libre + TAMANO_BLOQUE;
+    
+    for (int inicio = 0; inicio < filas; inicio += TAMANO_BLOQUE) {
+        int n = filas - inicio;
+        for (int v = 0; v < variables; v++) {
+            if (n >= TAMANO_BLOQUE) {
+                fuentes[v] = columnas[v] + inicio;
+                continue;
+            }
+            // Último bloque incompleto: se copia lo que hay y el resto se
+            // llena con 1 (no se usa, pero así no aparecen divisiones por 0)
+            double *cola = colas + (size_t)v * TAMANO_BLOQUE;
+            memcpy(cola, columnas[v] + inicio, n * sizeof(double));
+            for (int j = n; j < TAMANO_BLOQUE; j++) {
+                cola[j] = 1.0;
+            }
+            fuentes[v] = cola;
+        }
         
-        if (evaluar_rpn(expresiones[i], &resultado)) {
-            printf("Resultado: %.2f\n\n", resultado);
+        int tope = -1;
+        for (int i = 0; i < programa->cantidad; i++) {
+            Instruccion instruccion = programa->instrucciones[i];
+            if (instruccion.codigo == OP_CONSTANTE) {
+                double constante = programa->constantes[instruccion.argumento];
+                tope++;
+                for (int j = 0; j < TAMANO_BLOQUE; j++) {
+                    propios[tope][j] = constante;
+                }
+                valores[tope] = propios[tope];
+            } else if (instruccion.codigo == OP_VARIABLE) {
+                tope++;
+                valores[tope] = fuentes[instruccion.argumento];
+            } else {
+                operar_bloque(instruccion.codigo, libre, valores[tope - 1],
+                              valores[tope]);
+                tope--;
+                // El bloque propio del primer operando ya no se usa: pasa
+                // a ser el libre
+                double *resultado = libre;
+                libre = propios[tope];
+                propios[tope] = resultado;
+                valores[tope] = resultado;
+            }
+        }
+        int copiar = n < TAMANO_BLOQUE ? n : TAMANO_BLOQUE;
+        memcpy(resultados + inicio, valores[0], copiar * sizeof(double));
+    }
+    
+    free(memoria);
+    free(valores);
+    free(propios);
+    free(fuentes);
+    return 1;
+}
+
+// Programas decodificados y despacho
+//
+// decodificar_programa deja cada instrucción lista para ejecutar: el
+// valor de la constante va en la propia instrucción, el programa termina
+// con OP_FIN en vez de contar instrucciones y la pila ya se validó, así
+// que no hace falta verificar nada salvo la división por cero. Hay dos
+// formas de pasar de una instrucción a la siguiente:
+// - ejecutar_decodificado_switch: un lazo con un switch, C estándar. Todo
+//   el despacho pasa por un único salto indirecto, que el procesador
+//   predice mal cuando las operaciones se mezclan.
+// - ejecutar_decodificado_hilado: código hilado con goto calculado
+//   (extensión de GCC y Clang). Cada operación termina saltando a la
+//   siguiente por su cuenta, así que hay un salto indirecto por
+//   operación y el predictor aprende qué suele seguir a cada una.
+// Los dos reciben solo el arreglo de instrucciones, terminado en OP_FIN.
+// ejecutar_decodificado usa el hilado si el compilador lo permite.
+//
+// Para medir los fallos de predicción de cada uno:
+//     perf stat -e branches,branch-misses ./pila_calculadora despacho switch
+//     perf stat -e branches,branch-misses ./pila_calculadora despacho hilado
+
+#if defined(__GNUC__) && !defined(CALCULADORA_SIN_HILADO)
+#define CALCULADORA_CON_HILADO
+#endif
+
+typedef struct {
+    uint8_t codigo;             // Un CodigoOperacion
+    union {
+        double constante;       // OP_CONSTANTE
+        int variable;           // OP_VARIABLE
+    };
+} InstruccionDecodificada;
+
+typedef struct {
+    InstruccionDecodificada instrucciones[MAX_INSTRUCCIONES + 1];
+    int cantidad;               // Sin contar OP_FIN
+} ProgramaDecodificado;
+
+// Retorna 0 si el programa está mal formado o no entra en una Pila
+int decodificar_programa(const Programa *programa,
+                         ProgramaDecodificado *decodificado) {
+    int profundidad = programa_profundidad(programa);
+    if (profundidad < 0 || profundidad > MAX_PILA) {
+        return 0;
+    }
+    for (int i = 0; i < programa->cantidad; i++) {
+        Instruccion instruccion = programa->instrucciones[i];
+        InstruccionDecodificada *destino = &decodificado->instrucciones[i];
+        destino->codigo = instruccion.codigo;
+        if (instruccion.codigo == OP_CONSTANTE) {
+            destino->constante = programa->constantes[instruccion.argumento];
         } else {
-            printf("Error al evaluar\n\n");
+            destino->variable = instruccion.argumento;
+        }
+    }
+    decodificado->instrucciones[programa->cantidad].codigo = OP_FIN;
+    decodificado->cantidad = programa->cantidad;
+    return 1;
+}
+
+int ejecutar_decodificado_switch(const InstruccionDecodificada *instrucciones,
+                                 const double *valores, double *resultado) {
+    double pila[MAX_PILA];
+    int tope = -1;
+    const InstruccionDecodificada *instruccion = instrucciones;
+    for (;; instruccion++) {
+        switch (instruccion->codigo) {
+            case OP_CONSTANTE:
+                pila[++tope] = instruccion->constante;
+                break;
+            case OP_VARIABLE:
+                pila[++tope] = valores[instruccion->variable];
+                break;
+            case OP_SUMA:
+                tope--;
+                pila[tope] += pila[tope + 1];
+                break;
+            case OP_RESTA:
+                tope--;
+                pila[tope] -= pila[tope + 1];
+                break;
+            case OP_PRODUCTO:
+                tope--;
+                pila[tope] *= pila[tope + 1];
+                break;
+            case OP_DIVISION:
+                tope--;
+                if (pila[tope + 1] == 0) {
+                    return 0;  // División por cero
+                }
+                pila[tope] /= pila[tope + 1];
+                break;
+            default:
+                *resultado = pila[0];
+                return 1;
+        }
+    }
+}
+
+#ifdef CALCULADORA_CON_HILADO
+// &&etiqueta y goto * no son ISO C
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+
+int ejecutar_decodificado_hilado(const InstruccionDecodificada *instrucciones,
+                                 const double *valores, double *resultado) {
+    static const void *const etiquetas[] = {
+        [OP_CONSTANTE] = &&constante,
+        [OP_VARIABLE] = &&variable,
+        [OP_SUMA] = &&suma,
+        [OP_RESTA] = &&resta,
+        [OP_PRODUCTO] = &&producto,
+        [OP_DIVISION] = &&division,
+        [OP_FIN] = &&fin
+    };
+    double pila[MAX_PILA];
+    int tope = -1;
+    const InstruccionDecodificada *instruccion = instrucciones;
+
+#define SIGUIENTE() goto *etiquetas[(++instruccion)->codigo]
+    goto *etiquetas[instruccion->codigo];
+constante:
+    pila[++tope] = instruccion->constante;
+    SIGUIENTE();
+variable:
+    pila[++tope] = valores[instruccion->variable];
+    SIGUIENTE();
+suma:
+    tope--;
+    pila[tope] += pila[tope + 1];
+    SIGUIENTE();
+resta:
+    tope--;
+    pila[tope] -= pila[tope + 1];
+    SIGUIENTE();
+producto:
+    tope--;
+    pila[tope] *= pila[tope + 1];
+    SIGUIENTE();
+division:
+    tope--;
+    if (pila[tope + 1] == 0) {
+        return 0;  // División por cero
+    }
+    pila[tope] /= pila[tope + 1];
+    SIGUIENTE();
+fin:
+    *resultado = pila[0];
+    return 1;
+#undef SIGUIENTE
+}
+
+#pragma GCC diagnostic pop
+#endif
+
+// Evalúa un programa decodificado con el mejor despacho disponible
+int ejecutar_decodificado(const ProgramaDecodificado *programa,
+                          const double *valores, double *resultado) {
+#ifdef CALCULADORA_CON_HILADO
+    return ejecutar_decodificado_hilado(programa->instrucciones, valores,
+                                        resultado);
+#else
+    return ejecutar_decodificado_switch(programa->instrucciones, valores,
+                                        resultado);
+#endif
+}
+
+// Cache de expresiones
+//
+// Un servicio que recibe muchas veces las mismas expresiones puede
+// evitar volver a tokenizarlas: evaluar_rpn_cache busca el texto en una
+// cache de capacidad fija y, si está, ejecuta directamente su programa
+// decodificado. Si no está, la compila, la guarda y, con la cache llena,
+// descarta la usada hace más tiempo (LRU).
+//
+// Las entradas están en un arreglo y se enlazan por índices en dos
+// listas: la cadena de su balde en una tabla de dispersión indexada por
+// el hash FNV-1a del texto, y la lista doblemente enlazada del orden de
+// uso, con la más reciente al principio. Cada entrada tiene un solo
+// bloque de memoria con las instrucciones decodificadas, justas para su
+// programa, seguidas de una copia del texto, que se compara para que dos
+// expresiones con el mismo hash no se confundan.
+// Una cache no se puede compartir entre hilos sin un mutex.
+
+#define SIN_ENTRADA -1
+
+typedef struct {
+    uint64_t hash;
+    char *bloque;               // Instrucciones y texto
+    InstruccionDecodificada *instrucciones;  // NULL si no se pudo compilar
+    const char *texto;
+    int anterior;               // Orden de uso
+    int siguiente;
+    int siguiente_balde;        // Cadena del balde
+} EntradaCache;
+
+typedef struct {
+    EntradaCache *entradas;
+    int capacidad;
+    int usadas;
+    int *baldes;                // Primera entrada de cada balde
+    int cantidad_baldes;        // Potencia de 2
+    int mas_reciente;
+    int menos_reciente;
+    long aciertos;
+    long fallos;
+} CacheRpn;
+
+static uint64_t hash_texto(const char *texto) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const unsigned char *c = (const unsigned char *)texto; *c != '\0';
+         c++) {
+        hash ^= *c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Retorna NULL si capacidad no es positiva, es tan grande que la tabla
+// de baldes desbordaría int, o no hay memoria
+CacheRpn *cache_crear(int capacidad) {
+    if (capacidad <= 0 || capacidad > INT_MAX / 4) {
+        return NULL;
+    }
+    CacheRpn *cache = malloc(sizeof(CacheRpn));
+    if (cache == NULL) {
+        return NULL;
+    }
+    cache->cantidad_baldes = 1;
+    while (cache->cantidad_baldes < 2 * capacidad) {
+        cache->cantidad_baldes *= 2;
+    }
+    cache->entradas = malloc(capacidad * sizeof(EntradaCache));
+    cache->baldes = malloc(cache->cantidad_baldes * sizeof(int));
+    if (cache->entradas == NULL || cache->baldes == NULL) {
+        free(cache->entradas);
+        free(cache->baldes);
+        free(cache);
+        return NULL;
+    }
+    for (int i = 0; i < cache->cantidad_baldes; i++) {
+        cache->baldes[i] = SIN_ENTRADA;
+    }
+    cache->capacidad = capacidad;
+    cache->usadas = 0;
+    cache->mas_reciente = SIN_ENTRADA;
+    cache->menos_reciente = SIN_ENTRADA;
+    cache->aciertos = 0;
+    cache->fallos = 0;
+    return cache;
+}
+
+void cache_destruir(CacheRpn *cache) {
+    if (cache == NULL) {
+        return;
+    }
+    for (int i = 0; i < cache->usadas; i++) {
+        free(cache->entradas[i].bloque);
+    }
+    free(cache->entradas);
+    free(cache->baldes);
+    free(cache);
+}
+
+static void cache_desenlazar_uso(CacheRpn *cache, int indice) {
+    EntradaCache *entrada = &cache->entradas[indice];
+    if (entrada->anterior != SIN_ENTRADA) {
+        cache->entradas[entrada->anterior].siguiente = entrada->siguiente;
+    } else {
+        cache->mas_reciente = entrada->siguiente;
+    }
+    if (entrada->siguiente != SIN_ENTRADA) {
+        cache->entradas[entrada->siguiente].anterior = entrada->anterior;
+    } else {
+        cache->menos_reciente = entrada->anterior;
+    }
+}
+
+static void cache_poner_primera(CacheRpn *cache, int indice) {
+    EntradaCache *entrada = &cache->entradas[indice];
+    entrada->anterior = SIN_ENTRADA;
+    entrada->siguiente = cache->mas_reciente;
+    if (cache->mas_reciente != SIN_ENTRADA) {
+        cache->entradas[cache->mas_reciente].anterior = indice;
+    } else {
+        cache->menos_reciente = indice;
+    }
+    cache->mas_reciente = indice;
+}
+
+// Saca la entrada de la cadena de su balde
+static void cache_desenlazar_balde(CacheRpn *cache, int indice) {
+    int *enlace = &cache->baldes[cache->entradas[indice].hash &
+                                 (cache->cantidad_baldes - 1)];
+    while (*enlace != indice) {
+        enlace = &cache->entradas[*enlace].siguiente_balde;
+    }
+    *enlace = cache->entradas[indice].siguiente_balde;
+}
+
+// Retorna el índice de la entrada de texto, o SIN_ENTRADA
+static int cache_buscar(const CacheRpn *cache, const char *texto,
+                        uint64_t hash) {
+    int indice = cache->baldes[hash & (cache->cantidad_baldes - 1)];
+    while (indice != SIN_ENTRADA) {
+        const EntradaCache *entrada = &cache->entradas[indice];
+        if (entrada->hash == hash && strcmp(entrada->texto, texto) == 0) {
+            return indice;
+        }
+        indice = entrada->siguiente_balde;
+    }
+    return SIN_ENTRADA;
+}
+
+// Agrega una entrada para texto (descartando la menos reciente si la
+// cache está llena) y la compila. Retorna su índice, o SIN_ENTRADA si no
+// hay memoria.
+static int cache_agregar(CacheRpn *cache, const char *texto, uint64_t hash) {
+    Programa programa;
+    ProgramaDecodificado decodificado;
+    int cantidad = 0;
+    if (compilar_rpn(texto, &programa) && programa.cantidad_variables == 0 &&
+        decodificar_programa(&programa, &decodificado)) {
+        cantidad = decodificado.cantidad + 1;  // Con OP_FIN
+    }
+    size_t bytes_instrucciones = cantidad * sizeof(InstruccionDecodificada);
+    size_t largo = strlen(texto);
+    char *bloque = malloc(bytes_instrucciones + largo + 1);
+    if (bloque == NULL) {
+        return SIN_ENTRADA;
+    }
+    
+    int indice;
+    if (cache->usadas < cache->capacidad) {
+        indice = cache->usadas++;
+    } else {
+        indice = cache->menos_reciente;
+        cache_desenlazar_uso(cache, indice);
+        cache_desenlazar_balde(cache, indice);
+        free(cache->entradas[indice].bloque);
+    }
+    
+    EntradaCache *entrada = &cache->entradas[indice];
+    entrada->hash = hash;
+    entrada->bloque = bloque;
+    entrada->instrucciones = NULL;
+    if (cantidad > 0) {
+        memcpy(bloque, decodificado.instrucciones, bytes_instrucciones);
+        entrada->instrucciones = (InstruccionDecodificada *)bloque;
+    }
+    memcpy(bloque + bytes_instrucciones, texto, largo + 1);
+    entrada->texto = bloque + bytes_instrucciones;
+    
+    int *balde = &cache->baldes[hash & (cache->cantidad_baldes - 1)];
+    entrada->siguiente_balde = *balde;
+    *balde = indice;
+    cache_poner_primera(cache, indice);
+    return indice;
+}
+
+// Igual que evaluar_rpn, pero tokeniza y compila cada texto distinto una
+// sola vez mientras siga en la cache
+int evaluar_rpn_cache(CacheRpn *cache, const char *expresion,
+                      double *resultado) {
+    uint64_t hash = hash_texto(expresion);
+    int indice = cache_buscar(cache, expresion, hash);
+    if (indice != SIN_ENTRADA) {
+        cache->aciertos++;
+        if (indice != cache->mas_reciente) {
+            cache_desenlazar_uso(cache, indice);
+            cache_poner_primera(cache, indice);
+        }
+    } else {
+        cache->fallos++;
+        indice = cache_agregar(cache, expresion, hash);
+        if (indice == SIN_ENTRADA) {
+            return evaluar_rpn(expresion, resultado);
         }
     }
     
-    return 0;
+    // Lo que no se pudo compilar (un error, variables, o más constantes
+    // que MAX_CONSTANTES) lo resuelve evaluar_rpn, con sus mismos errores
+    const EntradaCache *entrada = &cache->entradas[indice];
+    if (entrada->instrucciones == NULL) {
+        return evaluar_rpn(expresion, resultado);
+    }
+#ifdef CALCULADORA_CON_HILADO
+    return ejecutar_decodificado_hilado(entrada->instrucciones, NULL,
+                                        resultado);
+#else
+    return ejecutar_decodificado_switch(entrada->instrucciones, NULL,
+                                        resultado);
+#endif
+}
+
+static double segundos_desde(clock_t inicio) {
+    return (double)(clock() - inicio) / CLOCKS_PER_SEC;
+}
+
+// Evalúa cada fórmula repeticiones veces con evaluar_rpn (texto con los
+// números ya escritos) y con el programa compilado (variables con los
+// mismos valores). Reporta millones de evaluaciones por segundo.
+static int benchmark(int repeticiones) {
+    const char *textos[] = {
+        "3 4 +",
+        "15 7 1 1 + - /",
+        "5 1 2 + 4 * + 3 -",
+        "3 4 + 2 *"
+    };
+    const char *formulas[] = {
+        "x y +",
+        "a b c c + - /",
+        "a b c + d * + e -",
+        "x y + 2 *"
+    };
+    const double valores[][5] = {
+        {3, 4},
+        {15, 7, 1},
+        {5, 1, 2, 4, 3},
+        {3, 4}
+    };
+    int n = sizeof(formulas) / sizeof(formulas[0]);
+    
+    printf("%-20s %14s %14s\n", "fórmula", "texto M/s", "compilada M/s");
+    for (int f = 0; f < n; f++) {
+        Programa programa;
+        if (!compilar_rpn(formulas[f], &programa)) {
+            printf("No se pudo compilar %s\n", formulas[f]);
+            return 1;
+        }
+        
+        double suma_texto = 0.0;
+        clock_t inicio = clock();
+        for (int r = 0; r < repeticiones; r++) {
+            double resultado = 0.0;
+            evaluar_rpn(textos[f], &resultado);
+            suma_texto += resultado;
+        }
+        double t_texto = segundos_desde(inicio);
+        
+        double suma_compilada = 0.0;
+        inicio = clock();
+        for (int r = 0; r < repeticiones; r++) {
+            double resultado = 0.0;
+            ejecutar_programa(&programa, valores[f], &resultado);
+            suma_compilada += resultado;
+        }
+        double t_compilada = segundos_desde(inicio);
+        
+        printf("%-20s %14.2f %14.2f%s\n", formulas[f],
+               repeticiones / t_texto / 1e6, repeticiones / t_compilada / 1e6,
+               suma_texto == suma_compilada ? "" : " (¡resultados distintos!)");
+    }
+    return 0;
+}
+
+// Aplica cada fórmula a filas filas con valores al azar y compara filas
+// por segundo de ejecutar_programa_lote contra evaluar_rpn fila por fila
+// (con el texto de cada fila ya armado) y contra ejecutar_programa fila
+// por fila
+static int benchmark_lote(int filas) {
+    const char *formulas[] = {
+        "x y +",
+        "a b c c + - /",
+        "a b c + d * + e -",
+        "x y + 2 *",
+        "a b * c d * + a c - /"
+    };
+    int n = sizeof(formulas) / sizeof(formulas[0]);
+    // evaluar_rpn necesita un texto por fila: se mide sobre menos filas
+    int filas_texto = filas < 100000 ? filas : 100000;
+    
+    // Hacen falta tantas columnas como variables use la fórmula que más
+    // usa, no MAX_VARIABLES
+    int variables = 0;
+    for (int f = 0; f < n; f++) {
+        Programa programa;
+        if (compilar_rpn(formulas[f], &programa) &&
+            programa.cantidad_variables > variables) {
+            variables = programa.cantidad_variables;
+        }
+    }
+    
+    double *columnas[MAX_VARIABLES];
+    double *resultados = malloc(filas * sizeof(double));
+    double *resultados_fila = malloc(filas * sizeof(double));
+    char *textos = malloc((size_t)filas_texto * 160);
+    int hay_memoria = resultados != NULL && resultados_fila != NULL &&
+                      textos != NULL;
+    for (int v = 0; v < variables; v++) {
+        columnas[v] = malloc(filas * sizeof(double));
+        hay_memoria = hay_memoria && columnas[v] != NULL;
+    }
+    int estado = 0;
+    if (!hay_memoria) {
+        fprintf(stderr, "No hay memoria para el benchmark\n");
+        estado = 1;
+        n = 0;
+    }
+    
+    // Valores entre 1 y 2: ninguna fórmula divide por cero. Los resultados
+    // se escriben antes de medir para no contar la primera escritura de
+    // cada página.
+    srand(42);
+    if (hay_memoria) {
+        memset(resultados, 0, filas * sizeof(double));
+        memset(resultados_fila, 0, filas * sizeof(double));
+    }
+    for (int v = 0; v < variables && hay_memoria; v++) {
+        for (int i = 0; i < filas; i++) {
+            columnas[v][i] = 1.0 + (double)rand() / RAND_MAX;
+        }
+    }
+    
+    printf("%d filas (evaluar_rpn sobre %d)\n", filas, filas_texto);
+    printf("%-24s %12s %12s %12s\n", "fórmula", "texto M/s", "fila M/s",
+           "lote M/s");
+    for (int f = 0; f < n; f++) {
+        Programa programa;
+        if (!compilar_rpn(formulas[f], &programa)) {
+            printf("No se pudo compilar %s\n", formulas[f]);
+            estado = 1;
+            break;
+        }
+        
+        // El texto de cada fila: la fórmula con los valores en lugar de
+        // las variables, escritos con todos sus dígitos
+        for (int i = 0; i < filas_texto; i++) {
+            char *texto = textos + (size_t)i * 160;
+            int largo = 0;
+            for (int k = 0; k < programa.cantidad; k++) {
+                Instruccion instruccion = programa.instrucciones[k];
+                const char *separador = k > 0 ? " " : "";
+                if (instruccion.codigo == OP_VARIABLE) {
+                    largo += snprintf(texto + largo, 160 - largo, "%s%.17g",
+                                      separador,
+                                      columnas[instruccion.argumento][i]);
+                } else if (instruccion.codigo == OP_CONSTANTE) {
+                    largo += snprintf(texto + largo, 160 - largo, "%s%.17g",
+                                      separador,
+                                      programa.constantes[instruccion.argumento]);
+                } else {
+                    largo += snprintf(texto + largo, 160 - largo, "%s%c",
+                                      separador,
+                                      "  +-*/"[instruccion.codigo]);
+                }
+            }
+        }
+        
+        int distintos = 0;
+        clock_t inicio = clock();
+        for (int i = 0; i < filas_texto; i++) {
+            double resultado = 0.0;
+            evaluar_rpn(textos + (size_t)i * 160, &resultado);
+            resultados[i] = resultado;
+        }
+        double t_texto = segundos_desde(inicio);
+        
+        double valores[MAX_VARIABLES];
+        inicio = clock();
+        for (int i = 0; i < filas; i++) {
+            for (int v = 0; v < programa.cantidad_variables; v++) {
+                valores[v] = columnas[v][i];
+            }
+            double resultado = 0.0;
+            ejecutar_programa(&programa, valores, &resultado);
+            resultados_fila[i] = resultado;
+        }
+        double t_fila = segundos_desde(inicio);
+        for (int i = 0; i < filas_texto; i++) {
+            distintos += resultados[i] != resultados_fila[i];
+        }
+        
+        inicio = clock();
+        ejecutar_programa_lote(&programa, (const double *const *)columnas,
+                               filas, resultados);
+        double t_lote = segundos_desde(inicio);
+        for (int i = 0; i < filas; i++) {
+            distintos += resultados[i] != resultados_fila[i];
+        }
+        
+        printf("%-24s %12.2f %12.2f %12.2f%s\n", formulas[f],
+               filas_texto / t_texto / 1e6, filas / t_fila / 1e6,
+               filas / t_lote / 1e6,
+               distintos == 0 ? "" : " (¡resultados distintos!)");
+        if (distintos != 0) {
+            estado = 1;
+        }
+    }
+    
+    for (int v = 0; v < variables; v++) {
+        free(columnas[v]);
+    }
+    free(resultados);
+    free(resultados_fila);
+    free(textos);
+    return estado;
+}
+
+// Escribe en texto, a partir de largo, una expresión al azar de hasta
+// niveles niveles con las primeras variables letras (a, b, ...), dígitos
+// y sobre todo 0 y 1 para que aparezcan constantes plegables y
+// operaciones neutras. Retorna el nuevo largo.
+static int generar_expresion(char *texto, int largo, int niveles,
+                             int variables) {
+    if (niveles == 0 || rand() % 3 == 0) {
+        int tipo = rand() % 20;
+        if (tipo < 9 && variables > 0) {
+            largo += sprintf(texto + largo, "%c ", 'a' + rand() % variables);
+        } else if (tipo < 16) {
+            largo += sprintf(texto + largo, "%d ", 2 + rand() % 8);
+        } else {
+            largo += sprintf(texto + largo, "%d ", tipo % 2);
+        }
+        return largo;
+    }
+    largo = generar_expresion(texto, largo, niveles - 1, variables);
+    largo = generar_expresion(texto, largo, niveles - 1, variables);
+    return largo + sprintf(texto + largo, "%c ", "+-*/"[rand() % 4]);
+}
+
+// Compila cantidad fórmulas generadas al azar y evalúa cada una
+// evaluaciones veces sin optimizar y optimizada
+static int benchmark_optimizar(int cantidad, int evaluaciones) {
+    Programa *originales = malloc(cantidad * sizeof(Programa));
+    Programa *optimizados = malloc(cantidad * sizeof(Programa));
+    if (originales == NULL || optimizados == NULL) {
+        fprintf(stderr, "No hay memoria para el benchmark\n");
+        free(originales);
+        free(optimizados);
+        return 1;
+    }
+    
+    srand(42);
+    long instrucciones_antes = 0;
+    long instrucciones_despues = 0;
+    for (int f = 0; f < cantidad; f++) {
+        char texto[512];
+        generar_expresion(texto, 0, 5, 5);
+        compilar_rpn(texto, &originales[f]);
+        optimizados[f] = originales[f];
+        optimizar_programa(&optimizados[f]);
+        instrucciones_antes += originales[f].cantidad;
+        instrucciones_despues += optimizados[f].cantidad;
+    }
+    
+    // Valores entre 1 y 2 para las variables
+    double valores[64][MAX_VARIABLES];
+    for (int i = 0; i < 64; i++) {
+        for (int v = 0; v < MAX_VARIABLES; v++) {
+            valores[i][v] = 1.0 + (double)rand() / RAND_MAX;
+        }
+    }
+    
+    double suma_antes = 0.0;
+    clock_t inicio = clock();
+    for (int f = 0; f < cantidad; f++) {
+        for (int r = 0; r < evaluaciones; r++) {
+            double resultado = 0.0;
+            if (ejecutar_programa(&originales[f], valores[r % 64], &resultado)) {
+                suma_antes += resultado;
+            }
+        }
+    }
+    double t_antes = segundos_desde(inicio);
+    
+    double suma_despues = 0.0;
+    inicio = clock();
+    for (int f = 0; f < cantidad; f++) {
+        for (int r = 0; r < evaluaciones; r++) {
+            double resultado = 0.0;
+            if (ejecutar_programa(&optimizados[f], valores[r % 64],
+                                  &resultado)) {
+                suma_despues += resultado;
+            }
+        }
+    }
+    double t_despues = segundos_desde(inicio);
+    
+    // Misma fórmula, mismos valores: el resultado tiene que coincidir
+    int distintos = 0;
+    for (int f = 0; f < cantidad; f++) {
+        for (int r = 0; r < 64; r++) {
+            double antes = 0.0;
+            double despues = 0.0;
+            int ok_antes = ejecutar_programa(&originales[f], valores[r], &antes);
+            int ok_despues = ejecutar_programa(&optimizados[f], valores[r],
+                                               &despues);
+            distintos += ok_antes != ok_despues ||
+                         (ok_antes && antes != despues);
+        }
+    }
+    
+    double total = (double)cantidad * evaluaciones;
+    printf("%d fórmulas generadas, %d evaluaciones de cada una\n", cantidad,
+           evaluaciones);
+    printf("%-16s %16s %12s\n", "", "instr/fórmula", "M eval/s");
+    printf("%-16s %15.1f %12.2f\n", "sin optimizar",
+           (double)instrucciones_antes / cantidad, total / t_antes / 1e6);
+    printf("%-16s %15.1f %12.2f\n", "optimizado",
+           (double)instrucciones_despues / cantidad, total / t_despues / 1e6);
+    printf("Resultados distintos: %d (sumas %.6g y %.6g)\n", distintos,
+           suma_antes, suma_despues);
+    
+    free(originales);
+    free(optimizados);
+    return distintos == 0 ? 0 : 1;
+}
+
+typedef int (*FuncionDecodificada)(const InstruccionDecodificada *,
+                                   const double *, double *);
+
+// Evalúa los programas con ejecutar en dos órdenes: cada uno vueltas
+// veces seguidas (el predictor se acostumbra a una sola fórmula) o
+// pasando de una fórmula a otra en cada evaluación. Deja en ns los
+// nanosegundos por operación de cada orden y retorna la suma de los
+// resultados para comparar despachos.
+static double medir_despacho(FuncionDecodificada ejecutar,
+                             const ProgramaDecodificado *programas,
+                             int cantidad, int vueltas,
+                             const double valores[][MAX_VARIABLES],
+                             double ns[2]) {
+    long operaciones = 0;
+    for (int f = 0; f < cantidad; f++) {
+        operaciones += programas[f].cantidad;
+    }
+    operaciones *= vueltas;
+    
+    double suma = 0.0;
+    clock_t inicio = clock();
+    for (int f = 0; f < cantidad; f++) {
+        for (int r = 0; r < vueltas; r++) {
+            double resultado = 0.0;
+            if (ejecutar(programas[f].instrucciones, valores[r % 64],
+                         &resultado)) {
+                suma += resultado;
+            }
+        }
+    }
+    ns[0] = segundos_desde(inicio) * 1e9 / operaciones;
+    
+    inicio = clock();
+    for (int r = 0; r < vueltas; r++) {
+        for (int f = 0; f < cantidad; f++) {
+            double resultado = 0.0;
+            if (ejecutar(programas[f].instrucciones, valores[r % 64],
+                         &resultado)) {
+                suma += resultado;
+            }
+        }
+    }
+    ns[1] = segundos_desde(inicio) * 1e9 / operaciones;
+    return suma;
+}
+
+// Compara los despachos sobre fórmulas generadas al azar. solo elige uno
+// ("switch" o "hilado") para medirlo aparte con perf stat; NULL mide los
+// dos.
+static int benchmark_despacho(const char *solo, int cantidad, int vueltas) {
+    ProgramaDecodificado *programas = malloc(cantidad *
+                                             sizeof(ProgramaDecodificado));
+    if (programas == NULL) {
+        fprintf(stderr, "No hay memoria para el benchmark\n");
+        return 1;
+    }
+    
+    srand(42);
+    for (int f = 0; f < cantidad; f++) {
+        char texto[512];
+        Programa programa;
+        generar_expresion(texto, 0, 5, 5);
+        compilar_rpn(texto, &programa);
+        decodificar_programa(&programa, &programas[f]);
+    }
+    double valores[64][MAX_VARIABLES];
+    for (int i = 0; i < 64; i++) {
+        for (int v = 0; v < MAX_VARIABLES; v++) {
+            valores[i][v] = 1.0 + (double)rand() / RAND_MAX;
+        }
+    }
+    
+    const char *nombres[] = {"switch", "hilado"};
+    FuncionDecodificada funciones[] = {
+        ejecutar_decodificado_switch,
+#ifdef CALCULADORA_CON_HILADO
+        ejecutar_decodificado_hilado
+#else
+        NULL
+#endif
+    };
+    
+    printf("%d fórmulas generadas, %d vueltas (ns por operación)\n",
+           cantidad, vueltas);
+    printf("%-10s %12s %12s\n", "despacho", "repetidas", "mezcladas");
+    double sumas[2] = {0.0, 0.0};
+    int medidos = 0;
+    for (int d = 0; d < 2; d++) {
+        if (solo != NULL && strcmp(solo, nombres[d]) != 0) {
+            continue;
+        }
+        if (funciones[d] == NULL) {
+            printf("%-10s %12s %12s\n", nombres[d], "n/d", "n/d");
+            continue;
+        }
+        double ns[2];
+        sumas[medidos++] = medir_despacho(funciones[d], programas, cantidad,
+                                          vueltas,
+                                          (const double (*)[MAX_VARIABLES])
+                                              valores, ns);
+        printf("%-10s %12.2f %12.2f\n", nombres[d], ns[0], ns[1]);
+    }
+    
+    int estado = 0;
+    if (medidos == 2 && sumas[0] != sumas[1]) {
+        printf("¡Los resultados de los despachos no coinciden!\n");
+        estado = 1;
+    }
+    free(programas);
+    return estado;
+}
+
+static int64_t nanosegundos_ahora(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static int comparar_int64(const void *a, const void *b) {
+    int64_t x = *(const int64_t *)a;
+    int64_t y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Percentil p (0 a 100) de n valores ya ordenados
+static int64_t percentil(const int64_t *ordenados, int n, double p) {
+    int indice = (int)(p / 100.0 * (n - 1));
+    return ordenados[indice];
+}
+
+static void imprimir_latencias(const char *nombre, int64_t *latencias,
+                               int n) {
+    int64_t total = 0;
+    for (int i = 0; i < n; i++) {
+        total += latencias[i];
+    }
+    qsort(latencias, n, sizeof(int64_t), comparar_int64);
+    printf("%-12s %10.1f %8lld %8lld %8lld %8lld\n", nombre,
+           (double)total / n, (long long)percentil(latencias, n, 50),
+           (long long)percentil(latencias, n, 90),
+           (long long)percentil(latencias, n, 99),
+           (long long)percentil(latencias, n, 99.9));
+}
+
+// Pedidos con distribución de Zipf (s = 1) sobre distintas expresiones
+// generadas: la expresión de rango k aparece con probabilidad
+// proporcional a 1/k. Mide la latencia de cada pedido con evaluar_rpn y
+// con evaluar_rpn_cache.
+static int benchmark_cache(int capacidad, int distintas, int pedidos) {
+    char (*textos)[512] = malloc(distintas * sizeof(*textos));
+    double *acumulada = malloc(distintas * sizeof(double));
+    int *elegidas = malloc(pedidos * sizeof(int));
+    int64_t *latencias = malloc(pedidos * sizeof(int64_t));
+    double *resultados = malloc(pedidos * sizeof(double));
+    CacheRpn *cache = cache_crear(capacidad);
+    int estado = 0;
+    if (textos == NULL || acumulada == NULL || elegidas == NULL ||
+        latencias == NULL || resultados == NULL || cache == NULL) {
+        fprintf(stderr, "No hay memoria para el benchmark\n");
+        estado = 1;
+        pedidos = 0;
+    }
+    
+    srand(42);
+    double total = 0.0;
+    for (int i = 0; i < distintas && estado == 0; i++) {
+        generar_expresion(textos[i], 0, 5, 0);
+        total += 1.0 / (i + 1);
+        acumulada[i] = total;
+    }
+    // Se elige el rango con una búsqueda binaria en la distribución
+    // acumulada
+    for (int p = 0; p < pedidos; p++) {
+        double u = (double)rand() / ((double)RAND_MAX + 1) * total;
+        int bajo = 0;
+        int alto = distintas - 1;
+        while (bajo < alto) {
+            int medio = bajo + (alto - bajo) / 2;
+            if (acumulada[medio] <= u) {
+                bajo = medio + 1;
+            } else {
+                alto = medio;
+            }
+        }
+        elegidas[p] = bajo;
+    }
+    
+    if (pedidos > 0) {
+        printf("%d pedidos sobre %d expresiones (Zipf), cache de %d\n",
+               pedidos, distintas, capacidad);
+        printf("%-12s %10s %8s %8s %8s %8s\n", "latencia ns", "media",
+               "p50", "p90", "p99", "p99.9");
+    }
+    
+    for (int p = 0; p < pedidos; p++) {
+        double resultado = 0.0;
+        int64_t inicio = nanosegundos_ahora();
+        int ok = evaluar_rpn(textos[elegidas[p]], &resultado);
+        latencias[p] = nanosegundos_ahora() - inicio;
+        resultados[p] = ok ? resultado : 0.0;
+    }
+    if (pedidos > 0) {
+        imprimir_latencias("sin cache", latencias, pedidos);
+    }
+    
+    int distintos = 0;
+    for (int p = 0; p < pedidos; p++) {
+        double resultado = 0.0;
+        int64_t inicio = nanosegundos_ahora();
+        int ok = evaluar_rpn_cache(cache, textos[elegidas[p]], &resultado);
+        latencias[p] = nanosegundos_ahora() - inicio;
+        distintos += (ok ? resultado : 0.0) != resultados[p];
+    }
+    if (pedidos > 0) {
+        imprimir_latencias("con cache", latencias, pedidos);
+        printf("Aciertos: %ld, fallos: %ld (%.1f%% de aciertos)\n",
+               cache->aciertos, cache->fallos,
+               100.0 * cache->aciertos / pedidos);
+        printf("Resultados distintos: %d\n", distintos);
+    }
+    
+    free(textos);
+    free(acumulada);
+    free(elegidas);
+    free(latencias);
+    free(resultados);
+    cache_destruir(cache);
+    return estado != 0 || distintos != 0;
+}
+
+// Prueba de rendimiento con varios hilos
+//
+// Cada hilo evalúa con evaluar_rpn las mismas expresiones pero empezando
+// por una distinta, así que en cada momento los hilos trabajan sobre
+// textos distintos, y compara cada resultado con el esperado. Con strtok
+// esto no sería posible: los hilos se pisarían la posición guardada.
+
+#define MAXIMO_HILOS 64
+
+static const char *expresiones_hilos[] = {
+    "3 4 +",
+    "15 7 1 1 + - /",
+    "5 1 2 + 4 * + 3 -",
+    "3 4 + 2 *",
+    "1.5 2.25 * 0.75 -",
+    "100 3 / 7 2 * +",
+    "-2 8 * 1e3 +",
+    "2 3 4 5 6 * * * *"
+};
+
+#define CANTIDAD_EXPRESIONES_HILOS \
+    ((int)(sizeof(expresiones_hilos) / sizeof(expresiones_hilos[0])))
+
+// Lo que recibe cada hilo
+typedef struct {
+    const double *esperados;
+    int primera;                // Expresión por la que empieza
+    int evaluaciones;
+    int errores;                // Resultados distintos del esperado
+    pthread_barrier_t *largada;
+} Trabajo;
+
+static void *hilo_evaluar(void *argumento) {
+    Trabajo *trabajo = argumento;
+    int errores = 0;
+    int indice = trabajo->primera;
+    pthread_barrier_wait(trabajo->largada);
+    for (int i = 0; i < trabajo->evaluaciones; i++) {
+        double resultado = 0.0;
+        if (!evaluar_rpn(expresiones_hilos[indice], &resultado) ||
+            resultado != trabajo->esperados[indice]) {
+            errores++;
+        }
+        indice++;
+        if (indice == CANTIDAD_EXPRESIONES_HILOS) {
+            indice = 0;
+        }
+    }
+    trabajo->errores = errores;
+    return NULL;
+}
+
+static double segundos_ahora(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Cantidades de hilos de los benchmarks: 1, 2, 4... y siempre maximo al
+// final
+static int siguiente_cantidad_hilos(int hilos, int maximo) {
+    if (hilos < maximo && hilos * 2 > maximo) {
+        return maximo;
+    }
+    return hilos * 2;
+}
+
+// Evalúa con 1, 2, 4... hasta maximo_hilos hilos y reporta millones de
+// expresiones por segundo entre todos
+static int benchmark_hilos(int maximo_hilos, int evaluaciones) {
+    double esperados[CANTIDAD_EXPRESIONES_HILOS];
+    for (int i = 0; i < CANTIDAD_EXPRESIONES_HILOS; i++) {
+        if (!evaluar_rpn(expresiones_hilos[i], &esperados[i])) {
+            printf("No se pudo evaluar %s\n", expresiones_hilos[i]);
+            return 1;
+        }
+    }
+    
+    int errores_totales = 0;
+    double base = 0.0;
+    printf("%6s %14s %13s %8s\n", "hilos", "M expr/s", "aceleración",
+           "errores");
+    for (int hilos = 1; hilos <= maximo_hilos;
+         hilos = siguiente_cantidad_hilos(hilos, maximo_hilos)) {
+        pthread_t ids[MAXIMO_HILOS];
+        Trabajo trabajos[MAXIMO_HILOS];
+        pthread_barrier_t largada;
+        // El hilo principal también pasa por la barrera para tomar el tiempo
+        pthread_barrier_init(&largada, NULL, hilos + 1);
+        for (int h = 0; h < hilos; h++) {
+            trabajos[h].esperados = esperados;
+            trabajos[h].primera = h % CANTIDAD_EXPRESIONES_HILOS;
+            trabajos[h].evaluaciones = evaluaciones;
+            trabajos[h].errores = 0;
+            trabajos[h].largada = &largada;
+            pthread_create(&ids[h], NULL, hilo_evaluar, &trabajos[h]);
+        }
+        pthread_barrier_wait(&largada);
+        double inicio = segundos_ahora();
+        int errores = 0;
+        for (int h = 0; h < hilos; h++) {
+            pthread_join(ids[h], NULL);
+            errores += trabajos[h].errores;
+        }
+        double segundos = segundos_ahora() - inicio;
+        pthread_barrier_destroy(&largada);
+        
+        double por_segundo = (double)hilos * evaluaciones / segundos / 1e6;
+        if (hilos == 1) {
+            base = por_segundo;
+        }
+        printf("%6d %14.2f %11.2fx %8d\n", hilos, por_segundo,
+               por_segundo / base, errores);
+        errores_totales += errores;
+    }
+    return errores_totales == 0 ? 0 : 1;
+}
+
+// Procesamiento de un flujo de expresiones
+//
+// procesar_flujo lee expresiones de a una por línea, las reparte entre
+// varios hilos trabajadores y escribe un resultado por línea en el mismo
+// orden de la entrada, sin cargarla entera en memoria:
+// - El hilo que llama lee líneas con getline en las ranuras libres de una
+//   ventana circular de VENTANA_FLUJO líneas. La línea n va en la ranura
+//   n % VENTANA_FLUJO, así que la ventana es a la vez la cola de trabajo y
+//   el buffer de reordenamiento.
+// - Cada trabajador toma hasta LOTE_FLUJO líneas seguidas, las evalúa y
+//   deja el texto del resultado en la ranura. Al terminar fuera de orden
+//   solo marca sus ranuras como listas.
+// - Un hilo escritor espera a que esté lista la próxima línea en orden,
+//   escribe todas las listas que siguen y libera sus ranuras para el
+//   lector.
+// Un único mutex protege los contadores; el texto de una ranura lo toca
+// solo quien la tiene asignada en ese momento, fuera del mutex.
+
+#define VENTANA_FLUJO 4096
+#define LOTE_FLUJO 64
+#define MAX_SALIDA 48
+
+typedef struct {
+    char *texto;                // Buffer de getline, se reutiliza
+    size_t capacidad_texto;
+    char salida[MAX_SALIDA];    // Resultado ya escrito como texto
+    int lista;
+} RanuraFlujo;
+
+typedef struct {
+    RanuraFlujo ranuras[VENTANA_FLUJO];
+    long leidas;                // Próxima línea a leer
+    long repartidas;            // Próxima línea a evaluar
+    long escritas;              // Próxima línea a escribir
+    int fin_entrada;
+    FILE *salida;
+    pthread_mutex_t candado;
+    pthread_cond_t hay_trabajo;
+    pthread_cond_t hay_resultado;
+    pthread_cond_t hay_lugar;
+} Flujo;
+
+static void evaluar_linea(RanuraFlujo *ranura) {
+    double resultado = 0.0;
+    int posicion = 0;
+    if (evaluar_rpn_posicion(ranura->texto, &resultado, &posicion)) {
+        snprintf(ranura->salida, MAX_SALIDA, "%.17g\n", resultado);
+    } else {
+        snprintf(ranura->salida, MAX_SALIDA, "error en la posición %d\n",
+                 posicion);
+    }
+}
+
+static void *hilo_trabajador_flujo(void *argumento) {
+    Flujo *flujo = argumento;
+    pthread_mutex_lock(&flujo->candado);
+    for (;;) {
+        while (flujo->repartidas == flujo->leidas && !flujo->fin_entrada) {
+            pthread_cond_wait(&flujo->hay_trabajo, &flujo->candado);
+        }
+        if (flujo->repartidas == flujo->leidas) {
+            break;  // Se terminó la entrada y no queda nada por evaluar
+        }
+        long primera = flujo->repartidas;
+        long ultima = flujo->leidas;
+        if (ultima - primera > LOTE_FLUJO) {
+            ultima = primera + LOTE_FLUJO;
+        }
+        flujo->repartidas = ultima;
+        pthread_mutex_unlock(&flujo->candado);
+        
+        for (long n = primera; n < ultima; n++) {
+            evaluar_linea(&flujo->ranuras[n % VENTANA_FLUJO]);
+        }
+        
+        pthread_mutex_lock(&flujo->candado);
+        for (long n = primera; n < ultima; n++) {
+            flujo->ranuras[n % VENTANA_FLUJO].lista = 1;
+        }
+        // Al escritor solo le sirve si está lista la próxima en orden
+        if (primera == flujo->escritas) {
+            pthread_cond_signal(&flujo->hay_resultado);
+        }
+    }
+    pthread_mutex_unlock(&flujo->candado);
+    return NULL;
+}
+
+static void *hilo_escritor_flujo(void *argumento) {
+    Flujo *flujo = argumento;
+    pthread_mutex_lock(&flujo->candado);
+    for (;;) {
+        while (!flujo->ranuras[flujo->escritas % VENTANA_FLUJO].lista &&
+               !(flujo->fin_entrada && flujo->escritas == flujo->leidas)) {
+            pthread_cond_wait(&flujo->hay_resultado, &flujo->candado);
+        }
+        if (flujo->escritas == flujo->leidas && flujo->fin_entrada) {
+            break;
+        }
+        long primera = flujo->escritas;
+        long ultima = primera;
+        while (ultima < flujo->leidas &&
+               flujo->ranuras[ultima % VENTANA_FLUJO].lista) {
+            ultima++;
+        }
+        pthread_mutex_unlock(&flujo->candado);
+        
+        for (long n = primera; n < ultima; n++) {
+            fputs(flujo->ranuras[n % VENTANA_FLUJO].salida, flujo->salida);
+        }
+        
+        pthread_mutex_lock(&flujo->candado);
+        for (long n = primera; n < ultima; n++) {
+            flujo->ranuras[n % VENTANA_FLUJO].lista = 0;
+        }
+        flujo->escritas = ultima;
+        pthread_cond_signal(&flujo->hay_lugar);
+    }
+    pthread_mutex_unlock(&flujo->candado);
+    return NULL;
+}
+
+// Evalúa cada línea de entrada con hilos trabajadores y escribe los
+// resultados en salida, en orden. Retorna la cantidad de líneas, o -1 si
+// no hay memoria.
+long procesar_flujo(FILE *entrada, FILE *salida, int hilos) {
+    Flujo *flujo = malloc(sizeof(Flujo));
+    if (flujo == NULL) {
+        return -1;
+    }
+    for (int i = 0; i < VENTANA_FLUJO; i++) {
+        flujo->ranuras[i].texto = NULL;
+        flujo->ranuras[i].capacidad_texto = 0;
+        flujo->ranuras[i].lista = 0;
+    }
+    flujo->leidas = 0;
+    flujo->repartidas = 0;
+    flujo->escritas = 0;
+    flujo->fin_entrada = 0;
+    flujo->salida = salida;
+    pthread_mutex_init(&flujo->candado, NULL);
+    pthread_cond_init(&flujo->hay_trabajo, NULL);
+    pthread_cond_init(&flujo->hay_resultado, NULL);
+    pthread_cond_init(&flujo->hay_lugar, NULL);
+    
+    pthread_t trabajadores[MAXIMO_HILOS];
+    pthread_t escritor;
+    for (int h = 0; h < hilos; h++) {
+        pthread_create(&trabajadores[h], NULL, hilo_trabajador_flujo, flujo);
+    }
+    pthread_create(&escritor, NULL, hilo_escritor_flujo, flujo);
+    
+    // Lee de a tantas líneas como ranuras libres haya (hasta LOTE_FLUJO)
+    // y recién entonces las publica
+    int fin = 0;
+    while (!fin) {
+        pthread_mutex_lock(&flujo->candado);
+        while (flujo->leidas - flujo->escritas == VENTANA_FLUJO) {
+            pthread_cond_wait(&flujo->hay_lugar, &flujo->candado);
+        }
+        long primera = flujo->leidas;
+        long libres = VENTANA_FLUJO - (primera - flujo->escritas);
+        pthread_mutex_unlock(&flujo->candado);
+        
+        long ultima = primera;
+        while (ultima - primera < libres && ultima - primera < LOTE_FLUJO) {
+            RanuraFlujo *ranura = &flujo->ranuras[ultima % VENTANA_FLUJO];
+            ssize_t largo = getline(&ranura->texto, &ranura->capacidad_texto,
+                                    entrada);
+            if (largo < 0) {
+                fin = 1;
+                break;
+            }
+            // Sin el fin de línea (\n o \r\n), las posiciones de error se
+            // refieren al texto visible de la línea
+            while (largo > 0 && (ranura->texto[largo - 1] == '\n' ||
+                                 ranura->texto[largo - 1] == '\r')) {
+                ranura->texto[--largo] = '\0';
+            }
+            ultima++;
+        }
+        
+        pthread_mutex_lock(&flujo->candado);
+        flujo->leidas = ultima;
+        flujo->fin_entrada = fin;
+        if (fin) {
+            pthread_cond_broadcast(&flujo->hay_trabajo);
+            pthread_cond_signal(&flujo->hay_resultado);
+        } else {
+            pthread_cond_signal(&flujo->hay_trabajo);
+        }
+        pthread_mutex_unlock(&flujo->candado);
+    }
+    
+    for (int h = 0; h < hilos; h++) {
+        pthread_join(trabajadores[h], NULL);
+    }
+    pthread_join(escritor, NULL);
+    
+    long lineas = flujo->leidas;
+    for (int i = 0; i < VENTANA_FLUJO; i++) {
+        free(flujo->ranuras[i].texto);
+    }
+    pthread_mutex_destroy(&flujo->candado);
+    pthread_cond_destroy(&flujo->hay_trabajo);
+    pthread_cond_destroy(&flujo->hay_resultado);
+    pthread_cond_destroy(&flujo->hay_lugar);
+    free(flujo);
+    return lineas;
+}
+
+// Procesa el archivo (o la entrada estándar si es NULL o "-") y escribe
+// los resultados en la salida estándar; el tiempo va a la salida de error
+static int procesar_archivo(const char *ruta, int hilos) {
+    FILE *entrada = stdin;
+    if (ruta != NULL && strcmp(ruta, "-") != 0) {
+        entrada = fopen(ruta, "r");
+        if (entrada == NULL) {
+            perror(ruta);
+            return 1;
+        }
+    }
+    double inicio = segundos_ahora();
+    long lineas = procesar_flujo(entrada, stdout, hilos);
+    double segundos = segundos_ahora() - inicio;
+    if (entrada != stdin) {
+        fclose(entrada);
+    }
+    if (lineas < 0) {
+        fprintf(stderr, "No hay memoria para procesar el flujo\n");
+        return 1;
+    }
+    fprintf(stderr, "%ld expresiones en %.3f s (%.0f expr/s) con %d hilos\n",
+            lineas, segundos, lineas / segundos, hilos);
+    return 0;
+}
+
+// Genera un archivo temporal de lineas expresiones y lo procesa con 1,
+// 2, 4... y maximo_hilos trabajadores. La salida de cada corrida
+// tiene que ser idéntica a la de un solo hilo.
+static int benchmark_flujo(int maximo_hilos, int lineas) {
+    FILE *entrada = tmpfile();
+    FILE *referencia = tmpfile();
+    FILE *salida = tmpfile();
+    if (entrada == NULL || referencia == NULL || salida == NULL) {
+        perror("tmpfile");
+        return 1;
+    }
+    srand(42);
+    for (int i = 0; i < lineas; i++) {
+        char texto[512];
+        int largo = generar_expresion(texto, 0, 5, 0);
+        texto[largo - 1] = '\n';  // En lugar del último espacio
+        fwrite(texto, 1, largo, entrada);
+    }
+    
+    printf("%d expresiones, una por línea\n", lineas);
+    printf("%6s %14s %13s %10s\n", "hilos", "expr/s", "aceleración",
+           "salida");
+    double base = 0.0;
+    int estado = 0;
+    for (int hilos = 1; hilos <= maximo_hilos;
+         hilos = siguiente_cantidad_hilos(hilos, maximo_hilos)) {
+        FILE *destino = hilos == 1 ? referencia : salida;
+        rewind(entrada);
+        rewind(destino);
+        double inicio = segundos_ahora();
+        long procesadas = procesar_flujo(entrada, destino, hilos);
+        fflush(destino);
+        double segundos = segundos_ahora() - inicio;
+        if (procesadas != lineas) {
+            fprintf(stderr, "Se procesaron %ld de %d líneas\n", procesadas,
+                    lineas);
+            estado = 1;
+            break;
+        }
+        
+        // Compara la salida con la de un hilo
+        int igual = 1;
+        if (hilos > 1) {
+            rewind(referencia);
+            rewind(salida);
+            int a;
+            int b;
+            do {
+                a = fgetc(referencia);
+                b = fgetc(salida);
+            } while (a == b && a != EOF);
+            igual = a == b;
+        }
+        
+        double por_segundo = lineas / segundos;
+        if (hilos == 1) {
+            base = por_segundo;
+        }
+        printf("%6d %14.0f %12.2fx %10s\n", hilos, por_segundo,
+               por_segundo / base, igual ? "igual" : "DISTINTA");
+        if (!igual) {
+            estado = 1;
+        }
+    }
+    fclose(entrada);
+    fclose(referencia);
+    fclose(salida);
+    return estado;
+}
+
+static int demostracion(void) {
+    printf("Calculadora RPN (Reverse Polish Notation)\n\n");
+    
+    const char *expresiones[] = {
+        "3 4 +",           // 7
+        "15 7 1 1 + - /",  // 3
+        "5 1 2 + 4 * + 3 -", // 14
+        "3 4 + 2 *"        // 14
+    };
+    
+    int n = sizeof(expresiones) / sizeof(expresiones[0]);
+    
+    for (int i = 0; i < n; i++) {
+        double resultado;
+        printf("Expresión: %s\n", expresiones[i]);
+        
+        if (evaluar_rpn(expresiones[i], &resultado)) {
+            printf("Resultado: %.2f\n\n", resultado);
+        } else {
+            printf("Error al evaluar\n\n");
+        }
+    }
+    
+    // Expresiones con errores: se marca dónde se detectó cada uno
+    const char *erroneas[] = {
+        "3 4 + +",
+        "2 3x *",
+        "8 0 /",
+        "1 2"
+    };
+    int m = sizeof(erroneas) / sizeof(erroneas[0]);
+    for (int i = 0; i < m; i++) {
+        double resultado;
+        int posicion = 0;
+        if (!evaluar_rpn_posicion(erroneas[i], &resultado, &posicion)) {
+            printf("Error en: %s\n", erroneas[i]);
+            printf("          %*s^ (posición %d)\n\n", posicion, "",
+                   posicion);
+        }
+    }
+    
+    // Optimización: constantes plegadas y operaciones neutras
+    const char *optimizables[] = {
+        "15 7 1 1 + - /",
+        "x 1 * 0 + y 2 3 * * +"
+    };
+    for (int i = 0; i < 2; i++) {
+        Programa programa;
+        if (compilar_rpn(optimizables[i], &programa)) {
+            int antes = programa.cantidad;
+            optimizar_programa(&programa);
+            printf("Optimizada: %s (%d -> %d instrucciones, profundidad %d)\n",
+                   optimizables[i], antes, programa.cantidad,
+                   programa.profundidad);
+        }
+    }
+    printf("\n");
+    
+    // La misma fórmula compilada una vez y evaluada con distintos valores
+    Programa programa;
+    const char *formula = "x y + 2 *";
+    if (!compilar_rpn(formula, &programa)) {
+        printf("Error al compilar %s\n", formula);
+        return 1;
+    }
+    printf("Fórmula compilada: %s (%d instrucciones)\n", formula,
+           programa.cantidad);
+    int x = programa_variable(&programa, "x");
+    int y = programa_variable(&programa, "y");
+    for (int i = 1; i <= 3; i++) {
+        double valores[MAX_VARIABLES];
+        valores[x] = i;
+        valores[y] = 10 * i;
+        double resultado;
+        if (ejecutar_programa(&programa, valores, &resultado)) {
+            printf("x = %g, y = %g -> %.2f\n", valores[x], valores[y],
+                   resultado);
+        }
+    }
+    
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        return demostracion();
+    }
+    
+    if (strcmp(argv[1], "benchmark") == 0) {
+        return benchmark(2000000);
+    }
+    
+    if (strcmp(argv[1], "optimizar") == 0) {
+        int formulas = 1000;
+        if (argc == 3) {
+            formulas = atoi(argv[2]);
+        }
+        if (formulas <= 0) {
+            fprintf(stderr, "La cantidad de fórmulas debe ser positiva\n");
+            return 1;
+        }
+        return benchmark_optimizar(formulas, 5000);
+    }
+    
+    if (strcmp(argv[1], "despacho") == 0) {
+        const char *solo = argc == 3 ? argv[2] : NULL;
+        if (solo != NULL && strcmp(solo, "switch") != 0 &&
+            strcmp(solo, "hilado") != 0) {
+            fprintf(stderr, "Despacho desconocido: %s\n", solo);
+            return 1;
+        }
+        return benchmark_despacho(solo, 200, 25000);
+    }
+    
+    if (strcmp(argv[1], "cache") == 0) {
+        int capacidad = 1024;
+        if (argc == 3) {
+            capacidad = atoi(argv[2]);
+        }
+        if (capacidad <= 0) {
+            fprintf(stderr, "La capacidad debe ser positiva\n");
+            return 1;
+        }
+        return benchmark_cache(capacidad, 10000, 1000000);
+    }
+    
+    if (strcmp(argv[1], "lote") == 0) {
+        int filas = 4000000;
+        if (argc == 3) {
+            filas = atoi(argv[2]);
+        }
+        if (filas <= 0) {
+            fprintf(stderr, "La cantidad de filas debe ser positiva\n");
+            return 1;
+        }
+        return benchmark_lote(filas);
+    }
+    
+    if (strcmp(argv[1], "hilos") == 0) {
+        int maximo_hilos = 8;
+        if (argc == 3) {
+            maximo_hilos = atoi(argv[2]);
+        }
+        if (maximo_hilos <= 0 || maximo_hilos > MAXIMO_HILOS) {
+            fprintf(stderr, "La cantidad de hilos debe estar entre 1 y %d\n",
+                    MAXIMO_HILOS);
+            return 1;
+        }
+        return benchmark_hilos(maximo_hilos, 1000000);
+    }
+    
+    if (strcmp(argv[1], "procesar") == 0) {
+        int hilos = 4;
+        if (argc >= 3) {
+            hilos = atoi(argv[2]);
+        }
+        if (hilos <= 0 || hilos > MAXIMO_HILOS) {
+            fprintf(stderr, "La cantidad de hilos debe estar entre 1 y %d\n",
+                    MAXIMO_HILOS);
+            return 1;
+        }
+        return procesar_archivo(argc >= 4 ? argv[3] : NULL, hilos);
+    }
+    
+    if (strcmp(argv[1], "flujo") == 0) {
+        int maximo_hilos = 8;
+        if (argc == 3) {
+            maximo_hilos = atoi(argv[2]);
+        }
+        if (maximo_hilos <= 0 || maximo_hilos > MAXIMO_HILOS) {
+            fprintf(stderr, "La cantidad de hilos debe estar entre 1 y %d\n",
+                    MAXIMO_HILOS);
+            return 1;
+        }
+        return benchmark_flujo(maximo_hilos, 1000000);
+    }
+    
+    printf("Uso: %s [benchmark | optimizar [formulas] | "
+           "despacho [switch | hilado] | cache [capacidad] | lote [filas] | "
+           "hilos [max_hilos] | procesar [hilos] [archivo] | "
+           "flujo [max_hilos]]\n", argv[0]);
+    return 1;
 }